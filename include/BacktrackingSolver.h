@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "Solver.h"
+
+class BacktrackingSolver : public Solver {
+public:
+    static const uint16_t ALL_CANDIDATES = 0x1FF;
+    static const int PERMUTATION_COUNT = 256;
+
+    using PermutationTable = std::array<std::array<uint8_t, BOARD_SIZE>, PERMUTATION_COUNT>;
+
+    BacktrackingSolver();
+    bool Solve(Grid& board) override;
+    int CountSolutions(const Grid& board, int limit) override;
+    SolverEngine GetEngine() const override;
+    std::unique_ptr<Solver> Clone() const override;
+    void SetBranchingPolicy(BranchingPolicy policy) override;
+    BranchingPolicy GetBranchingPolicy() const;
+
+    bool Load(const Grid& board);
+    uint16_t GetCandidates(int row, int col) const;
+    int CountCandidates(int row, int col) const;
+    void Assign(int row, int col, int value);
+    void Unassign(int row, int col, int value);
+    bool HasOtherSolution(Grid& board, int row, int col, int value);
+
+private:
+    struct Frame {
+        uint8_t row;
+        uint8_t col;
+        uint8_t order;
+        uint8_t position;
+        uint8_t value;
+        uint16_t candidates;
+    };
+
+    int Search(Grid& board, int limit, bool keepSolution);
+    void Unwind(Grid& board, int depth);
+    bool SelectCell(const Grid& board, int& row, int& col) const;
+    bool SelectFirstEmpty(const Grid& board, int& row, int& col) const;
+    bool SelectMinRemaining(const Grid& board, int& row, int& col) const;
+    int CountEmptyPeers(const Grid& board, int row, int col) const;
+
+    BranchingPolicy mPolicy;
+
+    std::array<uint16_t, BOARD_SIZE> mRowMasks;
+    std::array<uint16_t, BOARD_SIZE> mColMasks;
+    std::array<uint16_t, BOARD_SIZE> mBoxMasks;
+    std::array<Frame, BOARD_SIZE * BOARD_SIZE> mStack;
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "PackedBoard.h"
+#include "Solver.h"
+#include "Span.h"
+
+using Puzzle = PackedBoard;
+
+struct Solution {
+    PackedBoard board;
+    bool solved;
+    uint32_t elapsedNs;
+};
+
+class BatchSolver {
+public:
+    static const uint32_t GRAIN_SIZE = 8;
+    static constexpr size_t MAX_BATCH = 1u << 30;
+
+    explicit BatchSolver(int threads = 0, SolverEngine engine = SolverEngine::BACKTRACKING);
+    ~BatchSolver();
+
+    BatchSolver(const BatchSolver&) = delete;
+    BatchSolver& operator=(const BatchSolver&) = delete;
+
+    size_t SolveBatch(Span<const Puzzle> puzzles, Span<Solution> solutions);
+    int GetThreadCount() const;
+    SolverEngine GetEngine() const;
+
+private:
+    struct alignas(64) Worker {
+        std::atomic<uint64_t> range;
+        std::unique_ptr<Solver> solver;
+        uint32_t victimSeed;
+        uint64_t solved;
+    };
+
+    void ThreadLoop(int index);
+    void RunWorker(int index);
+    bool TakeLocal(Worker& worker, uint32_t& begin, uint32_t& end);
+    bool Steal(int thief);
+    void SolveRange(Worker& worker, uint32_t begin, uint32_t end);
+    void RunBatch(const Puzzle* puzzles, Solution* solutions, uint32_t count);
+
+    SolverEngine mEngine;
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+    std::vector<std::thread> mThreads;
+
+    std::mutex mCallMutex;
+    std::mutex mMutex;
+    std::condition_variable mWake;
+    std::condition_variable mDone;
+    uint64_t mGeneration;
+    int mActive;
+    bool mStopping;
+
+    const Puzzle* mPuzzles;
+    Solution* mSolutions;
+    uint32_t mCount;
+    alignas(64) std::atomic<uint32_t> mCompleted;
+};
+
+size_t SolveBatch(Span<const Puzzle> puzzles, Span<Solution> solutions);
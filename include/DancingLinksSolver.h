@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "Solver.h"
+
+class DancingLinksSolver : public Solver {
+public:
+    static const int COLUMN_COUNT = 4 * BOARD_SIZE * BOARD_SIZE;
+    static const int ROW_COUNT = BOARD_SIZE * BOARD_SIZE * BOARD_SIZE;
+    static const int NODES_PER_ROW = 4;
+    static const int NODE_COUNT = 1 + COLUMN_COUNT + ROW_COUNT * NODES_PER_ROW;
+    static const int ROOT = 0;
+
+    DancingLinksSolver();
+    bool Solve(Grid& board) override;
+    int CountSolutions(const Grid& board, int limit) override;
+    SolverEngine GetEngine() const override;
+    std::unique_ptr<Solver> Clone() const override;
+
+private:
+    void BuildMatrix();
+    bool CoverGivens(const Grid& board, int& coveredRows);
+    void UncoverGivens(int coveredRows);
+    void Cover(int column);
+    void Uncover(int column);
+    void SelectRow(int node);
+    void DeselectRow(int node);
+    int ChooseColumn() const;
+    bool Search(int depth, Grid& board);
+    void Count(int limit, int& count);
+
+    static int RowIndex(int row, int col, int value);
+    static int FirstNodeOfRow(int rowIndex);
+
+    std::array<int16_t, NODE_COUNT> mLeft;
+    std::array<int16_t, NODE_COUNT> mRight;
+    std::array<int16_t, NODE_COUNT> mUp;
+    std::array<int16_t, NODE_COUNT> mDown;
+    std::array<int16_t, NODE_COUNT> mColumn;
+    std::array<int16_t, COLUMN_COUNT + 1> mSize;
+    std::array<bool, COLUMN_COUNT + 1> mCovered;
+    std::array<int16_t, BOARD_SIZE * BOARD_SIZE> mGivenRows;
+    std::array<int16_t, BOARD_SIZE * BOARD_SIZE> mSolution;
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+
+struct DrawStats {
+    int rects;
+    int drawCalls;
+};
+
+class DrawBatch {
+public:
+    static const size_t INITIAL_CAPACITY = 256;
+
+    DrawBatch();
+
+    void SetColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+    void SetBlendMode(SDL_BlendMode mode);
+    void FillRect(const SDL_Rect* rect);
+    void DrawRect(const SDL_Rect* rect);
+    void Flush(SDL_Renderer* renderer);
+
+    DrawStats EndFrame();
+    const DrawStats& GetLastFrameStats() const;
+
+private:
+    struct Run {
+        SDL_Color color;
+        SDL_BlendMode blendMode;
+        int first;
+        int count;
+    };
+
+    struct Item {
+        SDL_Rect rect;
+        int run;
+    };
+
+    void Append(const SDL_Rect& rect);
+    bool MatchesState(const Run& run) const;
+
+    SDL_Color mColor;
+    SDL_BlendMode mBlendMode;
+    std::vector<Item> mItems;
+    std::vector<Run> mRuns;
+    std::vector<SDL_Rect> mRects;
+    DrawStats mFrameStats;
+    DrawStats mLastFrameStats;
+};
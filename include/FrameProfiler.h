@@ -0,0 +1,50 @@
+#pragma once
+
+#include <SDL.h>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class FramePhase {
+    INPUT,
+    UPDATE,
+    RENDER,
+    PRESENT,
+    COUNT
+};
+
+class FrameProfiler {
+public:
+    static constexpr size_t PHASE_COUNT = static_cast<size_t>(FramePhase::COUNT);
+    static constexpr size_t WINDOW_SIZE = 240;
+    static constexpr size_t HISTORY_SIZE = 36000;
+
+    using FrameTimes = std::array<float, PHASE_COUNT>;
+
+    FrameProfiler();
+
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const;
+    bool WasEnabled() const;
+
+    void BeginPhase(FramePhase phase);
+    void EndPhase(FramePhase phase);
+    void EndFrame();
+
+    uint64_t GetFrameCount() const;
+    const FrameTimes& GetLastFrame() const;
+    void GetPercentiles(FramePhase phase, float& p50, float& p95, float& p99) const;
+    bool WriteCsv(const std::string& path) const;
+
+private:
+    double mMillisecondsPerTick;
+    bool mEnabled;
+    bool mWasEnabled;
+    bool mRecording;
+    std::array<Uint64, PHASE_COUNT> mPhaseStart;
+    FrameTimes mCurrent;
+    FrameTimes mLast;
+    std::vector<FrameTimes> mHistory;
+    uint64_t mFrameCount;
+};
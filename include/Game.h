@@ -5,14 +5,20 @@
 #include <array>
 #include <vector>
 #include <string>
-#include "SudokuBoard.h"
+#include "GameSession.h"
+#include "PuzzlePool.h"
+#include "GlyphAtlas.h"
+#include "TextCache.h"
+#include "StaticLayer.h"
+#include "DrawBatch.h"
+#include "FrameProfiler.h"
 
-enum class GameState {
+enum class LayerId {
+    GRID,
     MENU,
-    PLAYING,
-    SOLVED,
-    WIN,
-    GAME_OVER
+    WIN_SCREEN,
+    GAME_OVER_SCREEN,
+    COUNT
 };
 
 class Game {
@@ -23,43 +29,64 @@ public:
     bool Initialize();
     void RunLoop();
     void Shutdown();
+    void SetRenderOnDemand(bool enabled);
 
 private:
     void ProcessInput();
+    void HandleEvent(const SDL_Event& event);
+    void WaitForEvent();
+    void MarkDirty();
     void Update(float deltaTime);
     void Render();
+    void DrawLayer(LayerId id, SDL_Rect area, void (Game::*drawStatic)());
+    void InvalidateLayers();
+    void DestroyLayers();
     void DrawGrid();
+    void DrawGridLayer();
+    void DrawMenuLayer();
+    void DrawWinLayer();
+    void DrawGameOverLayer();
     void DrawNumbers();
     void DrawSelection();
+    void DrawConflicts();
     void DrawUI();
     void DrawMenu();
     void DrawWinScreen();
     void DrawGameOverScreen();
     void DrawTimer();
+    void DrawProfilerHud();
     void HandleMouseClick(int x, int y);
     void RenderText(const std::string& text, int x, int y, SDL_Color color);
     void RenderCenteredText(const std::string& text, SDL_Rect box, SDL_Color color);
     void RenderCenteredTextWithFont(const std::string& text, SDL_Rect box, SDL_Color color, TTF_Font* font);
-    void AddMistake();
+    void RenderCenteredGlyphs(const std::string& text, SDL_Rect box, SDL_Color color);
+    void RenderGlyphs(const std::string& text, int x, int y, SDL_Color color);
+    void StartNewGame();
+    void ReturnToMenu();
     std::string FormatTime(int seconds);
 
     SDL_Window* mWindow;
     SDL_Renderer* mRenderer;
     TTF_Font* mFont;
     TTF_Font* mTitleFont;
+    GlyphAtlas mGlyphAtlas;
+    TextCache mTextCache;
+    std::array<StaticLayer, static_cast<size_t>(LayerId::COUNT)> mLayers;
+    bool mLayersSupported;
+    DrawBatch mDrawBatch;
+    int mLastDrawCalls;
+    FrameProfiler mProfiler;
     bool mIsRunning;
-    GameState mGameState;
-    SudokuBoard mBoard;
+    GameSession mSession;
+    PuzzlePool mPuzzlePool;
     int mSelectedRow;
     int mSelectedCol;
     bool mIsEditing;
     int mSelectedDifficulty;
-    float mWinScreenTimer;
-    int mMistakes;
-    const int MAX_MISTAKES = 5;
-    float mGameOverTimer;
-    float mGameTime;
-    bool mTimerActive;
+    bool mShowConflicts;
+    bool mRenderOnDemand;
+    bool mNeedsRedraw;
+    int mLastDrawnSecond;
     
     const int WINDOW_WIDTH = 600;
     const int WINDOW_HEIGHT = 700;
@@ -67,4 +94,5 @@ private:
     const int BOARD_OFFSET_X = 75;
     const int BOARD_OFFSET_Y = 50;
     const int CELL_SIZE = 50;
+    const char* PROFILE_CSV_PATH = "frame_profile.csv";
 }; 
\ No newline at end of file
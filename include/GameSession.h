@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include "SudokuBoard.h"
+
+enum class GameState {
+    MENU,
+    PLAYING,
+    SOLVED,
+    WIN,
+    GAME_OVER
+};
+
+enum class MoveResult {
+    REJECTED,
+    PLACED,
+    CLEARED,
+    MISTAKE
+};
+
+class GameSession {
+public:
+    static const int MAX_MISTAKES = 5;
+
+    GameSession();
+    GameSession(const GameSession&) = delete;
+    GameSession& operator=(const GameSession&) = delete;
+
+    void Start(int difficulty);
+    void Start(const GeneratedPuzzle& puzzle);
+    bool StartFromId(uint64_t id);
+    void ReturnToMenu();
+    void Update(float deltaTime);
+
+    MoveResult EnterNumber(int row, int col, int value);
+    MoveResult ClearEntry(int row, int col);
+    bool ApplyHint(int& row, int& col, int& value);
+
+    GameState GetState() const;
+    int GetDifficulty() const;
+    int GetMistakes() const;
+    float GetElapsedTime() const;
+    bool IsTimerActive() const;
+    float GetStateTime() const;
+    uint64_t GetMoveCount() const;
+
+    const SudokuBoard& GetBoard() const;
+    SudokuBoard& GetBoard();
+
+private:
+    void BeginPlaying(int difficulty);
+    void AddMistake();
+    void OnBoardSolved();
+
+    SudokuBoard mBoard;
+    GameState mState;
+    int mDifficulty;
+    int mMistakes;
+    float mElapsedTime;
+    float mStateTime;
+    bool mTimerActive;
+    uint64_t mMoveCount;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <array>
+#include <string>
+#include <vector>
+
+class GlyphAtlas {
+public:
+    static const int FIRST_GLYPH = 32;
+    static const int LAST_GLYPH = 126;
+    static const int GLYPH_COUNT = LAST_GLYPH - FIRST_GLYPH + 1;
+    static const int ATLAS_WIDTH = 1024;
+    static const int GLYPH_PADDING = 1;
+
+    GlyphAtlas();
+    ~GlyphAtlas();
+
+    bool Build(SDL_Renderer* renderer, const std::vector<TTF_Font*>& fonts);
+    void Destroy();
+    bool Supports(TTF_Font* font, const std::string& text) const;
+    void MeasureText(TTF_Font* font, const std::string& text, int& width, int& height) const;
+    void DrawText(SDL_Renderer* renderer, TTF_Font* font, const std::string& text, int x, int y, SDL_Color color) const;
+
+private:
+    struct Glyph {
+        SDL_Rect source;
+        int advance;
+    };
+
+    struct FontGlyphs {
+        TTF_Font* font;
+        int height;
+        bool kerning;
+        std::array<Glyph, GLYPH_COUNT> glyphs;
+    };
+
+    const FontGlyphs* FindFont(TTF_Font* font) const;
+    static int Kerning(const FontGlyphs& glyphs, char previous, char current);
+
+    SDL_Texture* mTexture;
+    std::vector<FontGlyphs> mFonts;
+};
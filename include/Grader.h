@@ -0,0 +1,36 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "Solver.h"
+
+enum class Technique {
+    NONE,
+    HIDDEN_SINGLE,
+    NAKED_SINGLE,
+    LOCKED_CANDIDATES,
+    NAKED_PAIR,
+    HIDDEN_PAIR,
+    NAKED_TRIPLE,
+    HIDDEN_TRIPLE,
+    X_WING,
+    SWORDFISH,
+    XY_WING,
+    CHAIN,
+    GUESSING,
+    COUNT
+};
+
+struct PuzzleGrade {
+    Technique hardest = Technique::NONE;
+    int score = 0;
+    std::array<uint16_t, static_cast<size_t>(Technique::COUNT)> steps = {};
+};
+
+class Grader {
+public:
+    static bool Grade(const Solver::Grid& givens, PuzzleGrade& grade);
+    static int GetWeight(Technique technique);
+    static const char* GetName(Technique technique);
+    static bool ParseName(const char* name, Technique& technique);
+};
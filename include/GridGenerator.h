@@ -0,0 +1,12 @@
+#pragma once
+
+#include "Random.h"
+#include "Solver.h"
+
+class GridGenerator {
+public:
+    static const int BASE_GRID_COUNT = 64;
+
+    static void Generate(Solver::Grid& grid, RandomEngine& rng);
+    static void Generate(Solver::Grid& grid, LegacyRandomEngine& rng);
+};
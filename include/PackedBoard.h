@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "Solver.h"
+
+class alignas(64) PackedBoard {
+public:
+    static const int BOARD_SIZE = Solver::BOARD_SIZE;
+    static const int CELL_COUNT = BOARD_SIZE * BOARD_SIZE;
+    static const int TEXT_LENGTH = CELL_COUNT;
+
+    PackedBoard()
+        : mGivens{}
+        , mCells{}
+    {
+    }
+
+    int Get(int index) const {
+        uint8_t pair = mCells[index >> 1];
+        return (index & 1) ? pair >> 4 : pair & 0x0F;
+    }
+
+    int Get(int row, int col) const {
+        return Get(row * BOARD_SIZE + col);
+    }
+
+    void Set(int index, int value) {
+        uint8_t& pair = mCells[index >> 1];
+        uint8_t nibble = static_cast<uint8_t>(value & 0x0F);
+        if (index & 1) {
+            pair = static_cast<uint8_t>((pair & 0x0F) | (nibble << 4));
+        } else {
+            pair = static_cast<uint8_t>((pair & 0xF0) | nibble);
+        }
+    }
+
+    void Set(int row, int col, int value) {
+        Set(row * BOARD_SIZE + col, value);
+    }
+
+    bool IsGiven(int index) const {
+        return (mGivens[index >> 6] >> (index & 63)) & 1u;
+    }
+
+    bool IsGiven(int row, int col) const {
+        return IsGiven(row * BOARD_SIZE + col);
+    }
+
+    void SetGiven(int index, bool given) {
+        uint64_t bit = uint64_t(1) << (index & 63);
+        if (given) {
+            mGivens[index >> 6] |= bit;
+        } else {
+            mGivens[index >> 6] &= ~bit;
+        }
+    }
+
+    void SetGiven(int row, int col, bool given) {
+        SetGiven(row * BOARD_SIZE + col, given);
+    }
+
+    static PackedBoard FromGrid(const Solver::Grid& grid);
+    static PackedBoard FromGivens(const Solver::Grid& givens);
+
+    void Assign(const Solver::Grid& grid);
+    void ToGrid(Solver::Grid& grid) const;
+    PackedBoard GetGivens() const;
+    int CountGivens() const;
+
+    bool Parse(const char* text, size_t length);
+    void Format(char* text) const;
+
+    uint64_t Hash() const;
+    bool operator==(const PackedBoard& other) const;
+    bool operator!=(const PackedBoard& other) const;
+
+private:
+    std::array<uint64_t, 2> mGivens;
+    std::array<uint8_t, 48> mCells;
+};
+
+static_assert(sizeof(PackedBoard) == 64, "PackedBoard must fill exactly one cache line");
+static_assert(std::is_trivially_copyable<PackedBoard>::value, "PackedBoard must be trivially copyable");
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "SpscQueue.h"
+#include "SudokuBoard.h"
+
+class PuzzlePool {
+public:
+    static const int DIFFICULTY_COUNT = 3;
+    static const size_t PUZZLES_PER_DIFFICULTY = 4;
+
+    PuzzlePool();
+    ~PuzzlePool();
+
+    void Start();
+    void Stop();
+    bool TryTake(int difficulty, GeneratedPuzzle& puzzle);
+    size_t GetReadyCount(int difficulty) const;
+
+private:
+    void WorkerLoop();
+    int PickDifficultyToRefill() const;
+
+    std::array<SpscQueue<GeneratedPuzzle, PUZZLES_PER_DIFFICULTY>, DIFFICULTY_COUNT> mQueues;
+    std::thread mWorker;
+    std::atomic<bool> mRunning;
+    std::mutex mWakeMutex;
+    std::condition_variable mWake;
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <utility>
+
+class Pcg32 {
+public:
+    using result_type = uint32_t;
+
+    static const uint64_t DEFAULT_STREAM = 0xDA3E39CB94B95BDBull;
+
+    explicit Pcg32(uint64_t seed = 0, uint64_t stream = DEFAULT_STREAM) {
+        Seed(seed, stream);
+    }
+
+    void Seed(uint64_t seed, uint64_t stream = DEFAULT_STREAM) {
+        mState = 0;
+        mIncrement = (stream << 1) | 1u;
+        Step();
+        mState += seed;
+        Step();
+    }
+
+    result_type operator()() {
+        uint64_t state = mState;
+        Step();
+        uint32_t xorshifted = static_cast<uint32_t>(((state >> 18) ^ state) >> 27);
+        uint32_t rotation = static_cast<uint32_t>(state >> 59);
+        return (xorshifted >> rotation) | (xorshifted << ((0u - rotation) & 31));
+    }
+
+    static constexpr result_type min() {
+        return 0;
+    }
+
+    static constexpr result_type max() {
+        return UINT32_MAX;
+    }
+
+private:
+    void Step() {
+        mState = mState * 6364136223846793005ull + mIncrement;
+    }
+
+    uint64_t mState;
+    uint64_t mIncrement;
+};
+
+using RandomEngine = Pcg32;
+using LegacyRandomEngine = std::mt19937;
+
+template <typename Engine>
+uint32_t RandomBelow(Engine& rng, uint32_t bound) {
+    uint64_t product = static_cast<uint64_t>(static_cast<uint32_t>(rng())) * bound;
+    uint32_t low = static_cast<uint32_t>(product);
+    if (low < bound) {
+        uint32_t threshold = (0u - bound) % bound;
+        while (low < threshold) {
+            product = static_cast<uint64_t>(static_cast<uint32_t>(rng())) * bound;
+            low = static_cast<uint32_t>(product);
+        }
+    }
+    return static_cast<uint32_t>(product >> 32);
+}
+
+inline uint32_t RandomBelow(LegacyRandomEngine& rng, uint32_t bound) {
+    uint32_t threshold = (0u - bound) % bound;
+    while (true) {
+        uint32_t value = static_cast<uint32_t>(rng());
+        if (value >= threshold) {
+            return value % bound;
+        }
+    }
+}
+
+template <typename Iterator, typename Engine>
+void Shuffle(Iterator first, Iterator last, Engine& rng) {
+    for (auto i = last - first; i > 1; --i) {
+        std::swap(first[i - 1], first[RandomBelow(rng, static_cast<uint32_t>(i))]);
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "Solver.h"
+
+enum class SimdLevel {
+    SCALAR,
+    SSE41,
+    AVX2
+};
+
+struct SimdKernels;
+
+class SimdSolver : public Solver {
+public:
+    static const int LANE_COUNT = 16;
+    static const uint16_t ALL_CANDIDATES = 0x1FF;
+
+    struct alignas(32) Lanes {
+        uint16_t v[LANE_COUNT];
+    };
+
+    struct alignas(32) State {
+        std::array<Lanes, BOARD_SIZE> rows;
+    };
+
+    SimdSolver();
+    bool Solve(Grid& board) override;
+    int CountSolutions(const Grid& board, int limit) override;
+    SolverEngine GetEngine() const override;
+    std::unique_ptr<Solver> Clone() const override;
+
+    SimdLevel GetSimdLevel() const;
+    void SetSimdLevel(SimdLevel level);
+    static SimdLevel DetectSimdLevel();
+
+private:
+    int Search(int limit, Grid* board);
+    bool LoadState(const Grid& board, State& state) const;
+    bool Propagate(State& state) const;
+    bool SelectBranchCell(const State& state, int& row, int& col) const;
+    uint16_t PickCandidate(uint16_t candidates);
+    void WriteSolution(const State& state, Grid& board) const;
+
+    SimdLevel mLevel;
+    const SimdKernels* mKernels;
+    std::array<State, BOARD_SIZE * BOARD_SIZE + 1> mStack;
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include "Random.h"
+
+enum class SolverEngine {
+    BACKTRACKING,
+    DANCING_LINKS,
+    SIMD_PROPAGATION
+};
+
+enum class BranchingPolicy {
+    FIRST_EMPTY,
+    MIN_REMAINING_VALUES
+};
+
+struct SolverStats {
+    uint64_t nodes = 0;
+    uint64_t backtracks = 0;
+    uint64_t solves = 0;
+};
+
+class Solver {
+public:
+    static const int BOARD_SIZE = 9;
+    static const int BOX_SIZE = 3;
+    static const int EMPTY_CELL = 0;
+
+    using Grid = std::array<std::array<int, BOARD_SIZE>, BOARD_SIZE>;
+
+    Solver();
+    virtual ~Solver() = default;
+
+    virtual bool Solve(Grid& board) = 0;
+    virtual int CountSolutions(const Grid& board, int limit) = 0;
+    virtual SolverEngine GetEngine() const = 0;
+    virtual std::unique_ptr<Solver> Clone() const = 0;
+    virtual void SetBranchingPolicy(BranchingPolicy policy);
+
+    void SetRandomSource(RandomEngine* rng);
+    void SetRandomSource(LegacyRandomEngine* rng);
+    const SolverStats& GetStats() const;
+    void ResetStats();
+
+    static int BoxIndex(int row, int col);
+
+protected:
+    bool HasRandomSource() const {
+        return mRng || mLegacyRng;
+    }
+
+    uint32_t DrawBelow(uint32_t bound) {
+        return mRng ? RandomBelow(*mRng, bound) : RandomBelow(*mLegacyRng, bound);
+    }
+
+    RandomEngine* mRng;
+    LegacyRandomEngine* mLegacyRng;
+    SolverStats mStats;
+};
+
+std::unique_ptr<Solver> CreateSolver(SolverEngine engine);
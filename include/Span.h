@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+template <typename T>
+class Span {
+public:
+    Span()
+        : mData(nullptr)
+        , mSize(0)
+    {
+    }
+
+    Span(T* data, size_t size)
+        : mData(data)
+        , mSize(size)
+    {
+    }
+
+    template <typename Container,
+        typename = typename std::enable_if<
+            std::is_convertible<decltype(std::declval<Container&>().data()), T*>::value>::type>
+    Span(Container& container)
+        : mData(container.data())
+        , mSize(container.size())
+    {
+    }
+
+    T* data() const {
+        return mData;
+    }
+
+    size_t size() const {
+        return mSize;
+    }
+
+    bool empty() const {
+        return mSize == 0;
+    }
+
+    T* begin() const {
+        return mData;
+    }
+
+    T* end() const {
+        return mData + mSize;
+    }
+
+    T& operator[](size_t index) const {
+        return mData[index];
+    }
+
+    Span subspan(size_t offset, size_t count) const {
+        return Span(mData + offset, count);
+    }
+
+private:
+    T* mData;
+    size_t mSize;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+template <typename T, size_t Capacity>
+class SpscQueue {
+public:
+    SpscQueue()
+        : mHead(0)
+        , mTail(0)
+    {
+    }
+
+    bool TryPush(const T& item) {
+        size_t tail = mTail.load(std::memory_order_relaxed);
+        if (tail - mHead.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        mSlots[tail % Capacity] = item;
+        mTail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPop(T& item) {
+        size_t head = mHead.load(std::memory_order_relaxed);
+        if (head == mTail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = mSlots[head % Capacity];
+        mHead.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t Size() const {
+        return mTail.load(std::memory_order_acquire) - mHead.load(std::memory_order_acquire);
+    }
+
+    bool IsFull() const {
+        return Size() >= Capacity;
+    }
+
+private:
+    alignas(64) std::atomic<size_t> mHead;
+    alignas(64) std::atomic<size_t> mTail;
+    std::array<T, Capacity> mSlots;
+};
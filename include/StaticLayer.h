@@ -0,0 +1,25 @@
+#pragma once
+
+#include <SDL.h>
+
+class StaticLayer {
+public:
+    StaticLayer();
+    ~StaticLayer();
+
+    static bool IsSupported(SDL_Renderer* renderer);
+
+    bool Begin(SDL_Renderer* renderer, const SDL_Rect& area);
+    void End(SDL_Renderer* renderer);
+    void Draw(SDL_Renderer* renderer) const;
+    bool IsValid() const;
+    void Invalidate();
+    void Destroy();
+
+private:
+    SDL_Texture* mTexture;
+    SDL_Rect mArea;
+    int mWidth;
+    int mHeight;
+    bool mValid;
+};
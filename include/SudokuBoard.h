@@ -1,9 +1,26 @@
 #pragma once
 
 #include <array>
-#include <vector>
-#include <random>
-#include <algorithm>
+#include <memory>
+#include <functional>
+#include <bitset>
+#include <string>
+#include "Solver.h"
+#include "BacktrackingSolver.h"
+#include "Grader.h"
+#include "PackedBoard.h"
+
+enum class GeneratorMode {
+    SOLVER,
+    TRANSFORM
+};
+
+struct GeneratedPuzzle {
+    PackedBoard givens;
+    PackedBoard solution;
+    int difficulty;
+    uint64_t id;
+};
 
 class SudokuBoard {
 public:
@@ -11,8 +28,33 @@ public:
     static const int EMPTY_CELL = 0;
     static const int BOX_SIZE = 3;
     
+    static const int PEER_COUNT = 20;
+    static const int GRADE_ATTEMPTS = 64;
+    static const uint32_t PUZZLE_ID_VERSION = 2;
+    static const uint32_t LEGACY_PUZZLE_ID_VERSION = 1;
+    
+    using Grid = Solver::Grid;
+    using ConflictMap = std::bitset<BOARD_SIZE * BOARD_SIZE>;
+    
     SudokuBoard();
+    explicit SudokuBoard(uint32_t seed);
+    SudokuBoard(const SudokuBoard& other);
+    SudokuBoard(SudokuBoard&& other) = default;
+    SudokuBoard& operator=(const SudokuBoard& other);
+    SudokuBoard& operator=(SudokuBoard&& other) = default;
+    void Seed(uint32_t seed);
     void NewGame(int difficulty);
+    void NewGame(int difficulty, uint32_t seed);
+    bool NewGame(int difficulty, Technique target, int maxAttempts = GRADE_ATTEMPTS);
+    bool GradePuzzle(PuzzleGrade& grade) const;
+    bool NewGameFromId(uint64_t id);
+    uint64_t GetPuzzleId() const;
+    int GetDifficulty() const;
+    static std::string FormatPuzzleId(uint64_t id);
+    static bool ParsePuzzleId(const char* text, uint64_t& id);
+    bool LoadPuzzle(const Grid& givens);
+    void LoadGeneratedPuzzle(const GeneratedPuzzle& puzzle);
+    GeneratedPuzzle ExportPuzzle() const;
     bool IsSolved() const;
     int GetCell(int row, int col) const;
     bool IsOriginalCell(int row, int col) const;
@@ -20,16 +62,53 @@ public:
     void SetCell(int row, int col, int value);
     void ClearCell(int row, int col);
     bool GetHint(int& row, int& col, int& value);
+    bool IsCorrectEntry(int row, int col, int value);
     bool IsNumberValid(int row, int col) const;
+    const ConflictMap& GetConflictMap() const;
+    bool HasUniqueSolution();
+    void SetSolvedCallback(std::function<void()> callback);
+    void SetSolverEngine(SolverEngine engine);
+    SolverEngine GetSolverEngine() const;
+    void SetBranchingPolicy(BranchingPolicy policy);
+    void SetGeneratorMode(GeneratorMode mode);
+    GeneratorMode GetGeneratorMode() const;
+    const SolverStats& GetSolverStats() const;
+    void ResetSolverStats();
 
 private:
-    std::array<std::array<int, BOARD_SIZE>, BOARD_SIZE> mBoard;
-    std::array<std::array<bool, BOARD_SIZE>, BOARD_SIZE> mOriginalCells;
-    void GenerateCompleteSolution();
-    void RemoveCells(int difficulty);
-    bool SolveBoard(std::array<std::array<int, BOARD_SIZE>, BOARD_SIZE>& board);
-    bool IsValidInRow(int row, int value) const;
-    bool IsValidInColumn(int col, int value) const;
-    bool IsValidInBox(int boxRow, int boxCol, int value) const;
-    std::mt19937 mRng;
+    using PeerTable = std::array<std::array<uint8_t, PEER_COUNT>, BOARD_SIZE * BOARD_SIZE>;
+    
+    PackedBoard mCells;
+    PackedBoard mSolution;
+    bool mHasSolution;
+    int mDifficulty;
+    uint64_t mPuzzleId;
+    std::array<std::array<uint8_t, BOARD_SIZE + 1>, BOARD_SIZE> mRowCounts;
+    std::array<std::array<uint8_t, BOARD_SIZE + 1>, BOARD_SIZE> mColCounts;
+    std::array<std::array<uint8_t, BOARD_SIZE + 1>, BOARD_SIZE> mBoxCounts;
+    int mFilledCount;
+    int mConflictCount;
+    ConflictMap mConflicts;
+    std::function<void()> mSolvedCallback;
+    template <typename Engine>
+    void Generate(int difficulty, Engine& rng);
+    template <typename Engine>
+    void GenerateCompleteSolution(Grid& board, Engine& rng);
+    uint64_t MakePuzzleId(int difficulty, uint32_t seed) const;
+    template <typename Engine>
+    void RemoveCells(Grid& board, int difficulty, Engine& rng);
+    bool EnsureSolution();
+    Grid GetGivens() const;
+    bool SolveBoard(Grid& board);
+    void AddValue(int row, int col, int value);
+    void RemoveValue(int row, int col);
+    void RecountCells();
+    void RefreshConflicts(int row, int col, int value);
+    bool HasConflict(int row, int col) const;
+    static const PeerTable& GetPeers();
+    RandomEngine mRng;
+    std::unique_ptr<Solver> mSolver;
+    BranchingPolicy mBranchingPolicy;
+    GeneratorMode mGeneratorMode;
+    BacktrackingSolver mDigger;
 }; 
\ No newline at end of file
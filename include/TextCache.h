@@ -0,0 +1,46 @@
+#pragma once
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+class TextCache {
+public:
+    static const size_t DEFAULT_CAPACITY = 64;
+
+    struct Entry {
+        uint64_t key;
+        std::string text;
+        TTF_Font* font;
+        SDL_Color color;
+        SDL_Texture* texture;
+        int width;
+        int height;
+    };
+
+    explicit TextCache(size_t capacity = DEFAULT_CAPACITY);
+    ~TextCache();
+
+    const Entry* Get(SDL_Renderer* renderer, TTF_Font* font, const std::string& text, SDL_Color color);
+    void Clear();
+
+    size_t GetSize() const;
+    size_t GetCapacity() const;
+    uint64_t GetHits() const;
+    uint64_t GetMisses() const;
+    void ResetCounters();
+
+private:
+    static uint64_t MakeKey(TTF_Font* font, const std::string& text, SDL_Color color);
+    static bool Matches(const Entry& entry, TTF_Font* font, const std::string& text, SDL_Color color);
+    void Evict(std::list<Entry>::iterator it);
+
+    size_t mCapacity;
+    uint64_t mHits;
+    uint64_t mMisses;
+    std::list<Entry> mEntries;
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> mIndex;
+};
@@ -0,0 +1,300 @@
+#include "BacktrackingSolver.h"
+#include "BitUtils.h"
+
+namespace {
+
+constexpr BacktrackingSolver::PermutationTable BuildPermutationTable() {
+    BacktrackingSolver::PermutationTable table = {};
+    uint32_t state = 0x9E3779B9u;
+    for (int p = 0; p < BacktrackingSolver::PERMUTATION_COUNT; ++p) {
+        for (int i = 0; i < BacktrackingSolver::BOARD_SIZE; ++i) {
+            table[p][i] = static_cast<uint8_t>(i);
+        }
+        if (p == 0) {
+            continue;
+        }
+        for (int i = BacktrackingSolver::BOARD_SIZE - 1; i > 0; --i) {
+            state = state * 1664525u + 1013904223u;
+            int j = static_cast<int>((state >> 16) % static_cast<uint32_t>(i + 1));
+            uint8_t temp = table[p][i];
+            table[p][i] = table[p][j];
+            table[p][j] = temp;
+        }
+    }
+    return table;
+}
+
+constexpr BacktrackingSolver::PermutationTable kPermutations = BuildPermutationTable();
+
+}
+
+BacktrackingSolver::BacktrackingSolver()
+    : mPolicy(BranchingPolicy::MIN_REMAINING_VALUES)
+{
+    mRowMasks.fill(0);
+    mColMasks.fill(0);
+    mBoxMasks.fill(0);
+}
+
+bool BacktrackingSolver::Load(const Grid& board) {
+    mRowMasks.fill(0);
+    mColMasks.fill(0);
+    mBoxMasks.fill(0);
+
+    for (int row = 0; row < BOARD_SIZE; ++row) {
+        for (int col = 0; col < BOARD_SIZE; ++col) {
+            int value = board[row][col];
+            if (value < EMPTY_CELL || value > BOARD_SIZE) {
+                return false;
+            }
+            if (value == EMPTY_CELL) {
+                continue;
+            }
+
+            uint16_t bit = static_cast<uint16_t>(1u << (value - 1));
+            if ((mRowMasks[row] | mColMasks[col] | mBoxMasks[BoxIndex(row, col)]) & bit) {
+                return false;
+            }
+            Assign(row, col, value);
+        }
+    }
+    return true;
+}
+
+bool BacktrackingSolver::Solve(Grid& board) {
+    mStats.solves++;
+    if (!Load(board)) {
+        return false;
+    }
+    return Search(board, 1, true) > 0;
+}
+
+int BacktrackingSolver::CountSolutions(const Grid& board, int limit) {
+    mStats.solves++;
+    if (!Load(board)) {
+        return 0;
+    }
+
+    Grid work = board;
+    return Search(work, limit, false);
+}
+
+SolverEngine BacktrackingSolver::GetEngine() const {
+    return SolverEngine::BACKTRACKING;
+}
+
+std::unique_ptr<Solver> BacktrackingSolver::Clone() const {
+    return std::make_unique<BacktrackingSolver>(*this);
+}
+
+uint16_t BacktrackingSolver::GetCandidates(int row, int col) const {
+    return static_cast<uint16_t>(~(mRowMasks[row] | mColMasks[col] | mBoxMasks[BoxIndex(row, col)]) & ALL_CANDIDATES);
+}
+
+int BacktrackingSolver::CountCandidates(int row, int col) const {
+    return CountBits(GetCandidates(row, col));
+}
+
+void BacktrackingSolver::Assign(int row, int col, int value) {
+    uint16_t bit = static_cast<uint16_t>(1u << (value - 1));
+    mRowMasks[row] |= bit;
+    mColMasks[col] |= bit;
+    mBoxMasks[BoxIndex(row, col)] |= bit;
+}
+
+void BacktrackingSolver::Unassign(int row, int col, int value) {
+    uint16_t bit = static_cast<uint16_t>(~(1u << (value - 1)));
+    mRowMasks[row] &= bit;
+    mColMasks[col] &= bit;
+    mBoxMasks[BoxIndex(row, col)] &= bit;
+}
+
+bool BacktrackingSolver::HasOtherSolution(Grid& board, int row, int col, int value) {
+    mStats.solves++;
+
+    uint16_t candidates = static_cast<uint16_t>(GetCandidates(row, col) & ~(1u << (value - 1)));
+    int count = 0;
+    for (int num = 1; num <= BOARD_SIZE && count == 0; ++num) {
+        if ((candidates & (1u << (num - 1))) == 0) {
+            continue;
+        }
+
+        board[row][col] = num;
+        Assign(row, col, num);
+        count = Search(board, 1, false);
+        Unassign(row, col, num);
+        board[row][col] = EMPTY_CELL;
+    }
+    return count > 0;
+}
+
+void BacktrackingSolver::SetBranchingPolicy(BranchingPolicy policy) {
+    mPolicy = policy;
+}
+
+BranchingPolicy BacktrackingSolver::GetBranchingPolicy() const {
+    return mPolicy;
+}
+
+int BacktrackingSolver::Search(Grid& board, int limit, bool keepSolution) {
+    int count = 0;
+    int depth = 0;
+    bool descend = true;
+
+    for (;;) {
+        if (descend) {
+            mStats.nodes++;
+
+            int row = -1;
+            int col = -1;
+            if (!SelectCell(board, row, col)) {
+                count++;
+                if (limit > 0 && count >= limit) {
+                    if (!keepSolution) {
+                        Unwind(board, depth);
+                    }
+                    return count;
+                }
+            } else {
+                uint16_t candidates = GetCandidates(row, col);
+                if (candidates == 0) {
+                    mStats.backtracks++;
+                } else {
+                    Frame& frame = mStack[depth++];
+                    frame.row = static_cast<uint8_t>(row);
+                    frame.col = static_cast<uint8_t>(col);
+                    frame.candidates = candidates;
+                    frame.order = static_cast<uint8_t>(HasRandomSource() ? DrawBelow(PERMUTATION_COUNT) : 0);
+                    frame.position = 0;
+                    frame.value = EMPTY_CELL;
+                }
+            }
+        }
+
+        if (depth == 0) {
+            return count;
+        }
+
+        Frame& frame = mStack[depth - 1];
+        if (frame.value != EMPTY_CELL) {
+            Unassign(frame.row, frame.col, frame.value);
+            board[frame.row][frame.col] = EMPTY_CELL;
+            frame.value = EMPTY_CELL;
+        }
+
+        descend = false;
+        const std::array<uint8_t, BOARD_SIZE>& order = kPermutations[frame.order];
+        while (frame.position < BOARD_SIZE) {
+            int num = order[frame.position++] + 1;
+            if (frame.candidates & (1u << (num - 1))) {
+                board[frame.row][frame.col] = num;
+                Assign(frame.row, frame.col, num);
+                frame.value = static_cast<uint8_t>(num);
+                descend = true;
+                break;
+            }
+        }
+
+        if (!descend) {
+            mStats.backtracks++;
+            depth--;
+        }
+    }
+}
+
+void BacktrackingSolver::Unwind(Grid& board, int depth) {
+    while (depth > 0) {
+        Frame& frame = mStack[--depth];
+        if (frame.value != EMPTY_CELL) {
+            Unassign(frame.row, frame.col, frame.value);
+            board[frame.row][frame.col] = EMPTY_CELL;
+            frame.value = EMPTY_CELL;
+        }
+    }
+}
+
+bool BacktrackingSolver::SelectCell(const Grid& board, int& row, int& col) const {
+    if (mPolicy == BranchingPolicy::MIN_REMAINING_VALUES) {
+        return SelectMinRemaining(board, row, col);
+    }
+    return SelectFirstEmpty(board, row, col);
+}
+
+bool BacktrackingSolver::SelectFirstEmpty(const Grid& board, int& row, int& col) const {
+    for (int r = 0; r < BOARD_SIZE; ++r) {
+        for (int c = 0; c < BOARD_SIZE; ++c) {
+            if (board[r][c] == EMPTY_CELL) {
+                row = r;
+                col = c;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool BacktrackingSolver::SelectMinRemaining(const Grid& board, int& row, int& col) const {
+    int bestCount = BOARD_SIZE + 1;
+    int bestDegree = -1;
+
+    for (int r = 0; r < BOARD_SIZE; ++r) {
+        for (int c = 0; c < BOARD_SIZE; ++c) {
+            if (board[r][c] != EMPTY_CELL) {
+                continue;
+            }
+
+            int count = CountCandidates(r, c);
+            if (count > bestCount) {
+                continue;
+            }
+
+            if (count <= 1) {
+                row = r;
+                col = c;
+                return true;
+            }
+
+            if (count < bestCount) {
+                row = r;
+                col = c;
+                bestCount = count;
+                bestDegree = -1;
+                continue;
+            }
+
+            if (bestDegree < 0) {
+                bestDegree = CountEmptyPeers(board, row, col);
+            }
+            int degree = CountEmptyPeers(board, r, c);
+            if (degree > bestDegree) {
+                row = r;
+                col = c;
+                bestDegree = degree;
+            }
+        }
+    }
+    return bestCount <= BOARD_SIZE;
+}
+
+int BacktrackingSolver::CountEmptyPeers(const Grid& board, int row, int col) const {
+    int count = 0;
+    for (int i = 0; i < BOARD_SIZE; ++i) {
+        if (i != col && board[row][i] == EMPTY_CELL) {
+            count++;
+        }
+        if (i != row && board[i][col] == EMPTY_CELL) {
+            count++;
+        }
+    }
+
+    int boxRowStart = (row / BOX_SIZE) * BOX_SIZE;
+    int boxColStart = (col / BOX_SIZE) * BOX_SIZE;
+    for (int r = boxRowStart; r < boxRowStart + BOX_SIZE; ++r) {
+        for (int c = boxColStart; c < boxColStart + BOX_SIZE; ++c) {
+            if (r != row && c != col && board[r][c] == EMPTY_CELL) {
+                count++;
+            }
+        }
+    }
+    return count;
+}
@@ -0,0 +1,243 @@
+#include "BatchSolver.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+uint64_t PackRange(uint32_t begin, uint32_t end) {
+    return (static_cast<uint64_t>(begin) << 32) | end;
+}
+
+uint32_t RangeBegin(uint64_t range) {
+    return static_cast<uint32_t>(range >> 32);
+}
+
+uint32_t RangeEnd(uint64_t range) {
+    return static_cast<uint32_t>(range);
+}
+
+uint32_t NextVictim(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+}
+
+BatchSolver::BatchSolver(int threads, SolverEngine engine)
+    : mEngine(engine)
+    , mGeneration(0)
+    , mActive(0)
+    , mStopping(false)
+    , mPuzzles(nullptr)
+    , mSolutions(nullptr)
+    , mCount(0)
+    , mCompleted(0)
+{
+    if (threads <= 0) {
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    for (int i = 0; i < threads; ++i) {
+        std::unique_ptr<Worker> worker(new Worker());
+        worker->range.store(0, std::memory_order_relaxed);
+        worker->solver = CreateSolver(engine);
+        worker->solver->SetBranchingPolicy(BranchingPolicy::MIN_REMAINING_VALUES);
+        worker->victimSeed = 0x9E3779B9u * static_cast<uint32_t>(i + 1);
+        worker->solved = 0;
+        mWorkers.push_back(std::move(worker));
+    }
+
+    for (int i = 1; i < threads; ++i) {
+        mThreads.emplace_back(&BatchSolver::ThreadLoop, this, i);
+    }
+}
+
+BatchSolver::~BatchSolver() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mWake.notify_all();
+
+    for (std::thread& thread : mThreads) {
+        thread.join();
+    }
+}
+
+size_t BatchSolver::SolveBatch(Span<const Puzzle> puzzles, Span<Solution> solutions) {
+    size_t count = std::min(puzzles.size(), solutions.size());
+    std::lock_guard<std::mutex> call(mCallMutex);
+
+    size_t solved = 0;
+    for (size_t offset = 0; offset < count; offset += MAX_BATCH) {
+        size_t batch = std::min(MAX_BATCH, count - offset);
+        for (std::unique_ptr<Worker>& worker : mWorkers) {
+            worker->solved = 0;
+        }
+
+        RunBatch(puzzles.data() + offset, solutions.data() + offset, static_cast<uint32_t>(batch));
+
+        for (const std::unique_ptr<Worker>& worker : mWorkers) {
+            solved += worker->solved;
+        }
+    }
+    return solved;
+}
+
+int BatchSolver::GetThreadCount() const {
+    return static_cast<int>(mWorkers.size());
+}
+
+SolverEngine BatchSolver::GetEngine() const {
+    return mEngine;
+}
+
+void BatchSolver::RunBatch(const Puzzle* puzzles, Solution* solutions, uint32_t count) {
+    uint64_t workerCount = mWorkers.size();
+
+    mPuzzles = puzzles;
+    mSolutions = solutions;
+    mCount = count;
+    mCompleted.store(0, std::memory_order_relaxed);
+
+    for (uint64_t i = 0; i < workerCount; ++i) {
+        uint32_t begin = static_cast<uint32_t>(count * i / workerCount);
+        uint32_t end = static_cast<uint32_t>(count * (i + 1) / workerCount);
+        mWorkers[i]->range.store(PackRange(begin, end), std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ++mGeneration;
+        mActive = static_cast<int>(workerCount) - 1;
+    }
+    mWake.notify_all();
+
+    RunWorker(0);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDone.wait(lock, [this]() {
+        return mActive == 0 && mCompleted.load(std::memory_order_acquire) == mCount;
+    });
+}
+
+void BatchSolver::ThreadLoop(int index) {
+    uint64_t seen = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWake.wait(lock, [this, seen]() { return mStopping || mGeneration != seen; });
+            if (mStopping) {
+                return;
+            }
+            seen = mGeneration;
+        }
+
+        RunWorker(index);
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            --mActive;
+        }
+        mDone.notify_one();
+    }
+}
+
+void BatchSolver::RunWorker(int index) {
+    Worker& worker = *mWorkers[index];
+    uint32_t begin, end;
+
+    while (true) {
+        if (TakeLocal(worker, begin, end)) {
+            SolveRange(worker, begin, end);
+        } else if (!Steal(index)) {
+            return;
+        }
+    }
+}
+
+bool BatchSolver::TakeLocal(Worker& worker, uint32_t& begin, uint32_t& end) {
+    uint64_t range = worker.range.load(std::memory_order_acquire);
+
+    while (true) {
+        uint32_t first = RangeBegin(range);
+        uint32_t last = RangeEnd(range);
+        if (first >= last) {
+            return false;
+        }
+
+        uint32_t next = std::min(last, first + GRAIN_SIZE);
+        if (worker.range.compare_exchange_weak(range, PackRange(next, last),
+                std::memory_order_acq_rel, std::memory_order_acquire)) {
+            begin = first;
+            end = next;
+            return true;
+        }
+    }
+}
+
+bool BatchSolver::Steal(int thief) {
+    Worker& self = *mWorkers[thief];
+    uint32_t workerCount = static_cast<uint32_t>(mWorkers.size());
+    uint32_t start = NextVictim(self.victimSeed) % workerCount;
+
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        uint32_t victimIndex = (start + i) % workerCount;
+        if (victimIndex == static_cast<uint32_t>(thief)) {
+            continue;
+        }
+
+        Worker& victim = *mWorkers[victimIndex];
+        uint64_t range = victim.range.load(std::memory_order_acquire);
+        while (true) {
+            uint32_t first = RangeBegin(range);
+            uint32_t last = RangeEnd(range);
+            if (first >= last) {
+                break;
+            }
+
+            uint32_t middle = first + (last - first) / 2;
+            if (victim.range.compare_exchange_weak(range, PackRange(first, middle),
+                    std::memory_order_acq_rel, std::memory_order_acquire)) {
+                self.range.store(PackRange(middle, last), std::memory_order_release);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void BatchSolver::SolveRange(Worker& worker, uint32_t begin, uint32_t end) {
+    using Clock = std::chrono::steady_clock;
+
+    Solver::Grid grid;
+    for (uint32_t i = begin; i < end; ++i) {
+        Solution& solution = mSolutions[i];
+        solution.board = mPuzzles[i];
+        solution.board.ToGrid(grid);
+
+        Clock::time_point start = Clock::now();
+        solution.solved = worker.solver->Solve(grid);
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+        solution.elapsedNs = static_cast<uint32_t>(std::min<int64_t>(elapsed, UINT32_MAX));
+        if (solution.solved) {
+            solution.board.Assign(grid);
+        }
+
+        worker.solved += solution.solved ? 1 : 0;
+    }
+
+    uint32_t count = end - begin;
+    if (mCompleted.fetch_add(count, std::memory_order_acq_rel) + count == mCount) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mDone.notify_one();
+    }
+}
+
+size_t SolveBatch(Span<const Puzzle> puzzles, Span<Solution> solutions) {
+    static BatchSolver solver;
+    return solver.SolveBatch(puzzles, solutions);
+}
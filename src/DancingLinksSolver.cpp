@@ -0,0 +1,269 @@
+#include "DancingLinksSolver.h"
+
+DancingLinksSolver::DancingLinksSolver() {
+    BuildMatrix();
+}
+
+bool DancingLinksSolver::Solve(Grid& board) {
+    mStats.solves++;
+
+    int coveredRows = 0;
+    if (!CoverGivens(board, coveredRows)) {
+        return false;
+    }
+
+    bool solved = Search(0, board);
+    UncoverGivens(coveredRows);
+    return solved;
+}
+
+int DancingLinksSolver::CountSolutions(const Grid& board, int limit) {
+    mStats.solves++;
+
+    int coveredRows = 0;
+    if (!CoverGivens(board, coveredRows)) {
+        return 0;
+    }
+
+    int count = 0;
+    Count(limit, count);
+    UncoverGivens(coveredRows);
+    return count;
+}
+
+SolverEngine DancingLinksSolver::GetEngine() const {
+    return SolverEngine::DANCING_LINKS;
+}
+
+std::unique_ptr<Solver> DancingLinksSolver::Clone() const {
+    return std::make_unique<DancingLinksSolver>(*this);
+}
+
+void DancingLinksSolver::BuildMatrix() {
+    for (int i = 0; i <= COLUMN_COUNT; ++i) {
+        mLeft[i] = static_cast<int16_t>(i == 0 ? COLUMN_COUNT : i - 1);
+        mRight[i] = static_cast<int16_t>(i == COLUMN_COUNT ? 0 : i + 1);
+        mUp[i] = static_cast<int16_t>(i);
+        mDown[i] = static_cast<int16_t>(i);
+        mColumn[i] = static_cast<int16_t>(i);
+        mSize[i] = 0;
+        mCovered[i] = false;
+    }
+
+    const int cellCount = BOARD_SIZE * BOARD_SIZE;
+    for (int row = 0; row < BOARD_SIZE; ++row) {
+        for (int col = 0; col < BOARD_SIZE; ++col) {
+            for (int value = 1; value <= BOARD_SIZE; ++value) {
+                int digit = value - 1;
+                int columns[NODES_PER_ROW] = {
+                    1 + row * BOARD_SIZE + col,
+                    1 + cellCount + row * BOARD_SIZE + digit,
+                    1 + 2 * cellCount + col * BOARD_SIZE + digit,
+                    1 + 3 * cellCount + BoxIndex(row, col) * BOARD_SIZE + digit
+                };
+
+                int first = FirstNodeOfRow(RowIndex(row, col, value));
+                for (int k = 0; k < NODES_PER_ROW; ++k) {
+                    int node = first + k;
+                    int column = columns[k];
+
+                    mLeft[node] = static_cast<int16_t>(first + (k + NODES_PER_ROW - 1) % NODES_PER_ROW);
+                    mRight[node] = static_cast<int16_t>(first + (k + 1) % NODES_PER_ROW);
+                    mColumn[node] = static_cast<int16_t>(column);
+
+                    mUp[node] = mUp[column];
+                    mDown[node] = static_cast<int16_t>(column);
+                    mDown[mUp[column]] = static_cast<int16_t>(node);
+                    mUp[column] = static_cast<int16_t>(node);
+                    mSize[column]++;
+                }
+            }
+        }
+    }
+}
+
+bool DancingLinksSolver::CoverGivens(const Grid& board, int& coveredRows) {
+    coveredRows = 0;
+
+    for (int row = 0; row < BOARD_SIZE; ++row) {
+        for (int col = 0; col < BOARD_SIZE; ++col) {
+            int value = board[row][col];
+            if (value < EMPTY_CELL || value > BOARD_SIZE) {
+                UncoverGivens(coveredRows);
+                coveredRows = 0;
+                return false;
+            }
+            if (value == EMPTY_CELL) {
+                continue;
+            }
+
+            int rowIndex = RowIndex(row, col, value);
+            int first = FirstNodeOfRow(rowIndex);
+            for (int k = 0; k < NODES_PER_ROW; ++k) {
+                if (mCovered[mColumn[first + k]]) {
+                    UncoverGivens(coveredRows);
+                    coveredRows = 0;
+                    return false;
+                }
+            }
+
+            SelectRow(first);
+            mGivenRows[coveredRows++] = static_cast<int16_t>(rowIndex);
+        }
+    }
+    return true;
+}
+
+void DancingLinksSolver::UncoverGivens(int coveredRows) {
+    for (int k = coveredRows - 1; k >= 0; --k) {
+        DeselectRow(FirstNodeOfRow(mGivenRows[k]));
+    }
+}
+
+void DancingLinksSolver::Cover(int column) {
+    mCovered[column] = true;
+    mLeft[mRight[column]] = mLeft[column];
+    mRight[mLeft[column]] = mRight[column];
+
+    for (int i = mDown[column]; i != column; i = mDown[i]) {
+        for (int j = mRight[i]; j != i; j = mRight[j]) {
+            mDown[mUp[j]] = mDown[j];
+            mUp[mDown[j]] = mUp[j];
+            mSize[mColumn[j]]--;
+        }
+    }
+}
+
+void DancingLinksSolver::Uncover(int column) {
+    for (int i = mUp[column]; i != column; i = mUp[i]) {
+        for (int j = mLeft[i]; j != i; j = mLeft[j]) {
+            mSize[mColumn[j]]++;
+            mDown[mUp[j]] = static_cast<int16_t>(j);
+            mUp[mDown[j]] = static_cast<int16_t>(j);
+        }
+    }
+
+    mLeft[mRight[column]] = static_cast<int16_t>(column);
+    mRight[mLeft[column]] = static_cast<int16_t>(column);
+    mCovered[column] = false;
+}
+
+void DancingLinksSolver::SelectRow(int node) {
+    Cover(mColumn[node]);
+    for (int j = mRight[node]; j != node; j = mRight[j]) {
+        Cover(mColumn[j]);
+    }
+}
+
+void DancingLinksSolver::DeselectRow(int node) {
+    for (int j = mLeft[node]; j != node; j = mLeft[j]) {
+        Uncover(mColumn[j]);
+    }
+    Uncover(mColumn[node]);
+}
+
+int DancingLinksSolver::ChooseColumn() const {
+    int best = mRight[ROOT];
+    for (int c = mRight[best]; c != ROOT && mSize[best] > 1; c = mRight[c]) {
+        if (mSize[c] < mSize[best]) {
+            best = c;
+        }
+    }
+    return best;
+}
+
+bool DancingLinksSolver::Search(int depth, Grid& board) {
+    mStats.nodes++;
+
+    if (mRight[ROOT] == ROOT) {
+        for (int k = 0; k < depth; ++k) {
+            int rowIndex = mSolution[k];
+            int cell = rowIndex / BOARD_SIZE;
+            board[cell / BOARD_SIZE][cell % BOARD_SIZE] = rowIndex % BOARD_SIZE + 1;
+        }
+        return true;
+    }
+
+    int column = ChooseColumn();
+    int size = mSize[column];
+    if (size == 0) {
+        mStats.backtracks++;
+        return false;
+    }
+
+    Cover(column);
+
+    int node = mDown[column];
+    if (HasRandomSource()) {
+        int offset = static_cast<int>(DrawBelow(static_cast<uint32_t>(size)));
+        for (int i = 0; i < offset; ++i) {
+            node = mDown[node];
+        }
+    }
+
+    bool solved = false;
+    for (int i = 0; i < size && !solved; ++i) {
+        if (node == column) {
+            node = mDown[node];
+        }
+
+        mSolution[depth] = static_cast<int16_t>((node - 1 - COLUMN_COUNT) / NODES_PER_ROW);
+        for (int j = mRight[node]; j != node; j = mRight[j]) {
+            Cover(mColumn[j]);
+        }
+
+        solved = Search(depth + 1, board);
+
+        for (int j = mLeft[node]; j != node; j = mLeft[j]) {
+            Uncover(mColumn[j]);
+        }
+        node = mDown[node];
+    }
+
+    Uncover(column);
+    if (!solved) {
+        mStats.backtracks++;
+    }
+    return solved;
+}
+
+void DancingLinksSolver::Count(int limit, int& count) {
+    mStats.nodes++;
+
+    if (mRight[ROOT] == ROOT) {
+        count++;
+        return;
+    }
+
+    int column = ChooseColumn();
+    if (mSize[column] == 0) {
+        mStats.backtracks++;
+        return;
+    }
+
+    Cover(column);
+    for (int node = mDown[column]; node != column; node = mDown[node]) {
+        for (int j = mRight[node]; j != node; j = mRight[j]) {
+            Cover(mColumn[j]);
+        }
+
+        Count(limit, count);
+
+        for (int j = mLeft[node]; j != node; j = mLeft[j]) {
+            Uncover(mColumn[j]);
+        }
+
+        if (limit > 0 && count >= limit) {
+            break;
+        }
+    }
+    Uncover(column);
+}
+
+int DancingLinksSolver::RowIndex(int row, int col, int value) {
+    return (row * BOARD_SIZE + col) * BOARD_SIZE + value - 1;
+}
+
+int DancingLinksSolver::FirstNodeOfRow(int rowIndex) {
+    return 1 + COLUMN_COUNT + rowIndex * NODES_PER_ROW;
+}
@@ -0,0 +1,110 @@
+#include "DrawBatch.h"
+
+DrawBatch::DrawBatch()
+    : mColor({0, 0, 0, 255})
+    , mBlendMode(SDL_BLENDMODE_NONE)
+    , mFrameStats({0, 0})
+    , mLastFrameStats({0, 0})
+{
+    mItems.reserve(INITIAL_CAPACITY);
+    mRuns.reserve(INITIAL_CAPACITY);
+    mRects.reserve(INITIAL_CAPACITY);
+}
+
+void DrawBatch::SetColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+    mColor = {r, g, b, a};
+}
+
+void DrawBatch::SetBlendMode(SDL_BlendMode mode) {
+    mBlendMode = mode;
+}
+
+void DrawBatch::FillRect(const SDL_Rect* rect) {
+    if (rect->w > 0 && rect->h > 0) {
+        Append(*rect);
+    }
+}
+
+void DrawBatch::DrawRect(const SDL_Rect* rect) {
+    if (rect->w <= 0 || rect->h <= 0) {
+        return;
+    }
+
+    Append({rect->x, rect->y, rect->w, 1});
+    if (rect->h > 1) {
+        Append({rect->x, rect->y + rect->h - 1, rect->w, 1});
+    }
+    if (rect->h > 2) {
+        Append({rect->x, rect->y + 1, 1, rect->h - 2});
+        if (rect->w > 1) {
+            Append({rect->x + rect->w - 1, rect->y + 1, 1, rect->h - 2});
+        }
+    }
+}
+
+void DrawBatch::Flush(SDL_Renderer* renderer) {
+    int offset = 0;
+    for (Run& run : mRuns) {
+        run.first = offset;
+        offset += run.count;
+        run.count = 0;
+    }
+
+    mRects.resize(mItems.size());
+    for (const Item& item : mItems) {
+        Run& run = mRuns[item.run];
+        mRects[run.first + run.count++] = item.rect;
+    }
+
+    for (const Run& run : mRuns) {
+        SDL_SetRenderDrawBlendMode(renderer, run.blendMode);
+        SDL_SetRenderDrawColor(renderer, run.color.r, run.color.g, run.color.b, run.color.a);
+        SDL_RenderFillRects(renderer, &mRects[run.first], run.count);
+        ++mFrameStats.drawCalls;
+    }
+
+    mItems.clear();
+    mRuns.clear();
+}
+
+DrawStats DrawBatch::EndFrame() {
+    mLastFrameStats = mFrameStats;
+    mFrameStats = {0, 0};
+    return mLastFrameStats;
+}
+
+const DrawStats& DrawBatch::GetLastFrameStats() const {
+    return mLastFrameStats;
+}
+
+void DrawBatch::Append(const SDL_Rect& rect) {
+    int blocker = -1;
+    for (const Item& item : mItems) {
+        if (item.run > blocker
+            && !MatchesState(mRuns[item.run])
+            && SDL_HasIntersection(&item.rect, &rect)) {
+            blocker = item.run;
+        }
+    }
+
+    int run = static_cast<int>(mRuns.size()) - 1;
+    while (run > blocker && !MatchesState(mRuns[run])) {
+        --run;
+    }
+    if (run <= blocker) {
+        mRuns.push_back({mColor, mBlendMode, 0, 0});
+        run = static_cast<int>(mRuns.size()) - 1;
+    }
+
+    mItems.push_back({rect, run});
+    ++mRuns[run].count;
+    ++mFrameStats.rects;
+}
+
+bool DrawBatch::MatchesState(const Run& run) const {
+    return run.blendMode == mBlendMode
+        && run.color.r == mColor.r
+        && run.color.g == mColor.g
+        && run.color.b == mColor.b
+        && run.color.a == mColor.a;
+}
@@ -0,0 +1,115 @@
+#include "FrameProfiler.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+FrameProfiler::FrameProfiler()
+    : mMillisecondsPerTick(1000.0 / static_cast<double>(SDL_GetPerformanceFrequency()))
+    , mEnabled(false)
+    , mWasEnabled(false)
+    , mRecording(false)
+    , mPhaseStart{}
+    , mCurrent{}
+    , mLast{}
+    , mFrameCount(0)
+{
+}
+
+void FrameProfiler::SetEnabled(bool enabled) {
+    mEnabled = enabled;
+    mWasEnabled = mWasEnabled || enabled;
+}
+
+bool FrameProfiler::IsEnabled() const {
+    return mEnabled;
+}
+
+bool FrameProfiler::WasEnabled() const {
+    return mWasEnabled;
+}
+
+void FrameProfiler::BeginPhase(FramePhase phase) {
+    if (!mRecording) {
+        return;
+    }
+    mPhaseStart[static_cast<size_t>(phase)] = SDL_GetPerformanceCounter();
+}
+
+void FrameProfiler::EndPhase(FramePhase phase) {
+    if (!mRecording) {
+        return;
+    }
+    size_t index = static_cast<size_t>(phase);
+    Uint64 elapsed = SDL_GetPerformanceCounter() - mPhaseStart[index];
+    mCurrent[index] += static_cast<float>(elapsed * mMillisecondsPerTick);
+}
+
+void FrameProfiler::EndFrame() {
+    if (mRecording) {
+        if (mHistory.empty()) {
+            mHistory.resize(HISTORY_SIZE);
+        }
+
+        mHistory[mFrameCount % HISTORY_SIZE] = mCurrent;
+        mLast = mCurrent;
+        ++mFrameCount;
+    }
+
+    mCurrent.fill(0.0f);
+    mRecording = mEnabled;
+}
+
+uint64_t FrameProfiler::GetFrameCount() const {
+    return mFrameCount;
+}
+
+const FrameProfiler::FrameTimes& FrameProfiler::GetLastFrame() const {
+    return mLast;
+}
+
+void FrameProfiler::GetPercentiles(FramePhase phase, float& p50, float& p95, float& p99) const {
+    p50 = p95 = p99 = 0.0f;
+
+    size_t count = static_cast<size_t>(std::min<uint64_t>(mFrameCount, WINDOW_SIZE));
+    if (count == 0) {
+        return;
+    }
+
+    std::array<float, WINDOW_SIZE> samples;
+    size_t index = static_cast<size_t>(phase);
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = mHistory[(mFrameCount - 1 - i) % HISTORY_SIZE][index];
+    }
+    std::sort(samples.begin(), samples.begin() + count);
+
+    auto rank = [count](double percentile) {
+        size_t position = static_cast<size_t>(std::ceil(percentile * count));
+        return std::min(count, std::max<size_t>(position, 1)) - 1;
+    };
+    p50 = samples[rank(0.50)];
+    p95 = samples[rank(0.95)];
+    p99 = samples[rank(0.99)];
+}
+
+bool FrameProfiler::WriteCsv(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    file << "frame,input_ms,update_ms,render_ms,present_ms,total_ms\n";
+
+    uint64_t first = mFrameCount > HISTORY_SIZE ? mFrameCount - HISTORY_SIZE : 0;
+    for (uint64_t frame = first; frame < mFrameCount; ++frame) {
+        const FrameTimes& times = mHistory[frame % HISTORY_SIZE];
+        float total = 0.0f;
+        file << frame;
+        for (float ms : times) {
+            file << ',' << ms;
+            total += ms;
+        }
+        file << ',' << total << '\n';
+    }
+
+    return static_cast<bool>(file);
+}
@@ -7,23 +7,24 @@
 #include <chrono>
 #include <iomanip>
 #include <sstream>
+#include <algorithm>
 
 Game::Game()
     : mWindow(nullptr)
     , mRenderer(nullptr)
     , mFont(nullptr)
     , mTitleFont(nullptr)
+    , mLayersSupported(false)
+    , mLastDrawCalls(-1)
     , mIsRunning(true)
-    , mGameState(GameState::MENU)
     , mSelectedRow(-1)
     , mSelectedCol(-1)
     , mIsEditing(false)
     , mSelectedDifficulty(2)
-    , mWinScreenTimer(0.0f)
-    , mMistakes(0)
-    , mGameOverTimer(0.0f)
-    , mGameTime(0.0f)
-    , mTimerActive(false)
+    , mShowConflicts(false)
+    , mRenderOnDemand(true)
+    , mNeedsRedraw(true)
+    , mLastDrawnSecond(0)
 {
 }
 
@@ -94,10 +95,19 @@ bool Game::Initialize() {
         }
     }
     
+    mGlyphAtlas.Build(mRenderer, {mFont, mTitleFont});
+    mLayersSupported = StaticLayer::IsSupported(mRenderer);
+    mPuzzlePool.Start();
+    
     return true;
 }
 
 void Game::Shutdown() {
+    mPuzzlePool.Stop();
+    DestroyLayers();
+    mTextCache.Clear();
+    mGlyphAtlas.Destroy();
+    
     if (mTitleFont) {
         TTF_CloseFont(mTitleFont);
         mTitleFont = nullptr;
@@ -122,101 +132,175 @@ void Game::Shutdown() {
     SDL_Quit();
 }
 
+void Game::SetRenderOnDemand(bool enabled) {
+    mRenderOnDemand = enabled;
+    mNeedsRedraw = true;
+}
+
 void Game::RunLoop() {
     Uint32 lastTicks = SDL_GetTicks();
     
     while (mIsRunning) {
+        if (mRenderOnDemand && !mNeedsRedraw) {
+            WaitForEvent();
+        }
+        
         Uint32 currentTicks = SDL_GetTicks();
         float deltaTime = (currentTicks - lastTicks) / 1000.0f;
         lastTicks = currentTicks;
         
+        mProfiler.BeginPhase(FramePhase::INPUT);
         ProcessInput();
+        mProfiler.EndPhase(FramePhase::INPUT);
+        
+        mProfiler.BeginPhase(FramePhase::UPDATE);
         Update(deltaTime);
-        Render();
+        mProfiler.EndPhase(FramePhase::UPDATE);
+        
+        if (!mRenderOnDemand || mNeedsRedraw) {
+            mProfiler.BeginPhase(FramePhase::RENDER);
+            Render();
+            mProfiler.EndPhase(FramePhase::RENDER);
+            
+            mProfiler.BeginPhase(FramePhase::PRESENT);
+            SDL_RenderPresent(mRenderer);
+            mProfiler.EndPhase(FramePhase::PRESENT);
+            
+            mProfiler.EndFrame();
+            mNeedsRedraw = false;
+        }
+    }
+    
+    if (mProfiler.WasEnabled()) {
+        mProfiler.WriteCsv(PROFILE_CSV_PATH);
     }
 }
 
+void Game::WaitForEvent() {
+    SDL_Event event;
+    bool received;
+    
+    if (mSession.IsTimerActive() && mSession.GetState() == GameState::PLAYING) {
+        float untilNextSecond = (mLastDrawnSecond + 1) - mSession.GetElapsedTime();
+        int timeout = static_cast<int>(untilNextSecond * 1000.0f) + 1;
+        received = SDL_WaitEventTimeout(&event, timeout > 0 ? timeout : 1) != 0;
+    } else {
+        received = SDL_WaitEvent(&event) != 0;
+    }
+    
+    if (received) {
+        mProfiler.BeginPhase(FramePhase::INPUT);
+        HandleEvent(event);
+        mProfiler.EndPhase(FramePhase::INPUT);
+    }
+}
+
+void Game::MarkDirty() {
+    mNeedsRedraw = true;
+}
+
 void Game::ProcessInput() {
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
-        switch (event.type) {
-            case SDL_QUIT:
-                mIsRunning = false;
-                break;
-                
-            case SDL_MOUSEBUTTONDOWN:
-                if (event.button.button == SDL_BUTTON_LEFT) {
-                    HandleMouseClick(event.button.x, event.button.y);
+        HandleEvent(event);
+    }
+}
+
+void Game::HandleEvent(const SDL_Event& event) {
+    switch (event.type) {
+        case SDL_QUIT:
+            mIsRunning = false;
+            break;
+            
+        case SDL_WINDOWEVENT:
+            if (event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+                DestroyLayers();
+            }
+            MarkDirty();
+            break;
+            
+        case SDL_RENDER_TARGETS_RESET:
+            InvalidateLayers();
+            MarkDirty();
+            break;
+            
+        case SDL_RENDER_DEVICE_RESET:
+            DestroyLayers();
+            mTextCache.Clear();
+            mGlyphAtlas.Build(mRenderer, {mFont, mTitleFont});
+            MarkDirty();
+            break;
+            
+        case SDL_MOUSEBUTTONDOWN:
+            MarkDirty();
+            if (event.button.button == SDL_BUTTON_LEFT) {
+                HandleMouseClick(event.button.x, event.button.y);
+            }
+            break;
+            
+        case SDL_KEYDOWN:
+            MarkDirty();
+            if (event.key.keysym.sym == SDLK_F3) {
+                mProfiler.SetEnabled(!mProfiler.IsEnabled());
+            }
+            else if (mSession.GetState() == GameState::PLAYING && mSelectedRow >= 0 && mSelectedCol >= 0) {
+                if (event.key.keysym.sym >= SDLK_1 && event.key.keysym.sym <= SDLK_9) {
+                    int number = event.key.keysym.sym - SDLK_0;
+                    mSession.EnterNumber(mSelectedRow, mSelectedCol, number);
                 }
-                break;
-                
-            case SDL_KEYDOWN:
-                if (mGameState == GameState::PLAYING && mSelectedRow >= 0 && mSelectedCol >= 0) {
-                    if (event.key.keysym.sym >= SDLK_1 && event.key.keysym.sym <= SDLK_9) {
-                        int number = event.key.keysym.sym - SDLK_0;
-                        if (!mBoard.IsOriginalCell(mSelectedRow, mSelectedCol)) {
-                            if (mBoard.IsValidMove(mSelectedRow, mSelectedCol, number)) {
-                                mBoard.SetCell(mSelectedRow, mSelectedCol, number);
-                            } else {
-                                AddMistake();
-                            }
-                        }
-                    }
-                    else if (event.key.keysym.sym == SDLK_BACKSPACE || event.key.keysym.sym == SDLK_DELETE) {
-                        if (!mBoard.IsOriginalCell(mSelectedRow, mSelectedCol)) {
-                            mBoard.ClearCell(mSelectedRow, mSelectedCol);
-                        }
-                    }
-                    else if (event.key.keysym.sym == SDLK_h) {
-                        int hintRow, hintCol, hintValue;
-                        if (mBoard.GetHint(hintRow, hintCol, hintValue)) {
-                            mSelectedRow = hintRow;
-                            mSelectedCol = hintCol;
-                            mBoard.SetCell(hintRow, hintCol, hintValue);
-                        }
-                    }
-                    else if (event.key.keysym.sym == SDLK_m) {
-                        mGameState = GameState::MENU;
-                        mSelectedRow = -1;
-                        mSelectedCol = -1;
-                        mTimerActive = false;
+                else if (event.key.keysym.sym == SDLK_BACKSPACE || event.key.keysym.sym == SDLK_DELETE) {
+                    mSession.ClearEntry(mSelectedRow, mSelectedCol);
+                }
+                else if (event.key.keysym.sym == SDLK_h) {
+                    int hintRow, hintCol, hintValue;
+                    if (mSession.ApplyHint(hintRow, hintCol, hintValue)) {
+                        mSelectedRow = hintRow;
+                        mSelectedCol = hintCol;
                     }
                 }
-                else if (mGameState == GameState::WIN || mGameState == GameState::GAME_OVER) {
-                    mGameState = GameState::MENU;
+                else if (event.key.keysym.sym == SDLK_c) {
+                    mShowConflicts = !mShowConflicts;
                 }
-                break;
-        }
+                else if (event.key.keysym.sym == SDLK_m) {
+                    ReturnToMenu();
+                }
+            }
+            else if (mSession.GetState() == GameState::WIN || mSession.GetState() == GameState::GAME_OVER) {
+                ReturnToMenu();
+            }
+            break;
     }
 }
 
-void Game::AddMistake() {
-    mMistakes++;
-    
-    if (mMistakes >= MAX_MISTAKES) {
-        mGameState = GameState::GAME_OVER;
-        mGameOverTimer = 0.0f;
+void Game::StartNewGame() {
+    GeneratedPuzzle puzzle;
+    if (mPuzzlePool.TryTake(mSelectedDifficulty, puzzle)) {
+        mSession.Start(puzzle);
+    } else {
+        mSession.Start(mSelectedDifficulty);
     }
+    
+    mSelectedRow = -1;
+    mSelectedCol = -1;
+    mLastDrawnSecond = 0;
+    MarkDirty();
+}
+
+void Game::ReturnToMenu() {
+    mSession.ReturnToMenu();
+    mSelectedRow = -1;
+    mSelectedCol = -1;
 }
 
 void Game::Update(float deltaTime) {
-    if (mTimerActive && mGameState == GameState::PLAYING) {
-        mGameTime += deltaTime;
-    }
-    
-    if (mGameState == GameState::PLAYING && mBoard.IsSolved()) {
-        mGameState = GameState::WIN;
-        mWinScreenTimer = 0.0f;
-        mTimerActive = false;
-    }
+    mSession.Update(deltaTime);
     
-    if (mGameState == GameState::WIN) {
-        mWinScreenTimer += deltaTime;
-    }
-    
-    if (mGameState == GameState::GAME_OVER) {
-        mGameOverTimer += deltaTime;
-        mTimerActive = false;
+    if (mSession.IsTimerActive() && mSession.GetState() == GameState::PLAYING) {
+        int second = static_cast<int>(mSession.GetElapsedTime());
+        if (second != mLastDrawnSecond) {
+            mLastDrawnSecond = second;
+            MarkDirty();
+        }
     }
 }
 
@@ -224,7 +308,7 @@ void Game::Render() {
     SDL_SetRenderDrawColor(mRenderer, 240, 240, 240, 255);
     SDL_RenderClear(mRenderer);
 
-    switch (mGameState) {
+    switch (mSession.GetState()) {
         case GameState::MENU:
             DrawMenu();
             break;
@@ -233,37 +317,36 @@ void Game::Render() {
         case GameState::WIN:
         case GameState::GAME_OVER:
             DrawSelection();
+            DrawConflicts();
             DrawGrid();
             DrawNumbers();
             
-            if (mGameState == GameState::PLAYING || mGameState == GameState::SOLVED) {
+            if (mSession.GetState() == GameState::PLAYING || mSession.GetState() == GameState::SOLVED) {
                 DrawUI();
                 DrawTimer();
             }
             
-            if (mGameState == GameState::WIN) {
+            if (mSession.GetState() == GameState::WIN) {
                 DrawWinScreen();
-            } else if (mGameState == GameState::GAME_OVER) {
+            } else if (mSession.GetState() == GameState::GAME_OVER) {
                 DrawGameOverScreen();
             }
             break;
     }
 
-    SDL_RenderPresent(mRenderer);
+    DrawProfilerHud();
+
+    mDrawBatch.Flush(mRenderer);
+    DrawStats stats = mDrawBatch.EndFrame();
+    if (stats.drawCalls != mLastDrawCalls) {
+        SDL_LogDebug(SDL_LOG_CATEGORY_RENDER, "Frame: %d rects in %d draw calls", stats.rects, stats.drawCalls);
+        mLastDrawCalls = stats.drawCalls;
+    }
 }
 
 void Game::DrawMenu() {
-    SDL_Rect titleRect = {
-        WINDOW_WIDTH / 2 - 200,
-        30,
-        400,
-        100
-    };
-    SDL_SetRenderDrawColor(mRenderer, 100, 100, 200, 255);
-    SDL_RenderFillRect(mRenderer, &titleRect);
-    
-    SDL_Color textColor = {255, 255, 255, 255};
-    RenderCenteredTextWithFont("SUDOKU", titleRect, textColor, mTitleFont);
+    SDL_Rect windowRect = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
+    DrawLayer(LayerId::MENU, windowRect, &Game::DrawMenuLayer);
     
     const char* difficulties[] = {"Easy", "Medium", "Hard"};
     for (int i = 0; i < 3; ++i) {
@@ -275,16 +358,30 @@ void Game::DrawMenu() {
         };
         
         if (i + 1 == mSelectedDifficulty) {
-            SDL_SetRenderDrawColor(mRenderer, 100, 200, 100, 255);
+            mDrawBatch.SetColor(100, 200, 100, 255);
         } else {
-            SDL_SetRenderDrawColor(mRenderer, 150, 150, 150, 255);
+            mDrawBatch.SetColor(150, 150, 150, 255);
         }
         
-        SDL_RenderFillRect(mRenderer, &diffBtn);
+        mDrawBatch.FillRect(&diffBtn);
         
         SDL_Color btnTextColor = {0, 0, 0, 255};
         RenderCenteredText(difficulties[i], diffBtn, btnTextColor);
     }
+}
+
+void Game::DrawMenuLayer() {
+    SDL_Rect titleRect = {
+        WINDOW_WIDTH / 2 - 200,
+        30,
+        400,
+        100
+    };
+    mDrawBatch.SetColor(100, 100, 200, 255);
+    mDrawBatch.FillRect(&titleRect);
+    
+    SDL_Color textColor = {255, 255, 255, 255};
+    RenderCenteredTextWithFont("SUDOKU", titleRect, textColor, mTitleFont);
     
     SDL_Rect startBtn = {
         WINDOW_WIDTH / 2 - 120,
@@ -292,21 +389,54 @@ void Game::DrawMenu() {
         240,
         70
     };
-    SDL_SetRenderDrawColor(mRenderer, 100, 200, 100, 255);
-    SDL_RenderFillRect(mRenderer, &startBtn);
+    mDrawBatch.SetColor(100, 200, 100, 255);
+    mDrawBatch.FillRect(&startBtn);
     
     SDL_Color startTextColor = {0, 0, 0, 255};
     RenderCenteredText("Start Game", startBtn, startTextColor);
 }
 
 void Game::DrawWinScreen() {
-    SDL_SetRenderDrawBlendMode(mRenderer, SDL_BLENDMODE_BLEND);
+    SDL_Rect windowRect = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
+    DrawLayer(LayerId::WIN_SCREEN, windowRect, &Game::DrawWinLayer);
+    
+    SDL_Color textColor = {0, 0, 0, 255};
+    std::string difficultyText;
+    switch (mSession.GetDifficulty()) {
+        case 1: difficultyText = "Easy"; break;
+        case 2: difficultyText = "Medium"; break;
+        case 3: difficultyText = "Hard"; break;
+        default: difficultyText = "Custom"; break;
+    }
+    
+    SDL_Rect msg2Rect = {
+        WINDOW_WIDTH / 2 - 150,
+        WINDOW_HEIGHT / 2 + 10,
+        300,
+        30
+    };
+    RenderCenteredText(difficultyText + " difficulty puzzle!", msg2Rect, textColor);
     
-    SDL_SetRenderDrawColor(mRenderer, 80, 80, 180, 180);
+    int totalSeconds = static_cast<int>(mSession.GetElapsedTime());
+    std::string timeText = "Time: " + FormatTime(totalSeconds);
+    
+    SDL_Rect timeRect = {
+        WINDOW_WIDTH / 2 - 100,
+        WINDOW_HEIGHT / 2 + 50,
+        200,
+        30
+    };
+    RenderCenteredText(timeText, timeRect, textColor);
+}
+
+void Game::DrawWinLayer() {
+    mDrawBatch.SetBlendMode(SDL_BLENDMODE_BLEND);
+    
+    mDrawBatch.SetColor(80, 80, 180, 180);
     SDL_Rect bgRect = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
-    SDL_RenderFillRect(mRenderer, &bgRect);
+    mDrawBatch.FillRect(&bgRect);
     
-    SDL_SetRenderDrawColor(mRenderer, 255, 240, 200, 230);
+    mDrawBatch.SetColor(255, 240, 200, 230);
     SDL_Rect congratsBox = {
         WINDOW_WIDTH / 2 - 200,
         WINDOW_HEIGHT / 2 - 150,
@@ -314,9 +444,9 @@ void Game::DrawWinScreen() {
         300
     };
     
-    SDL_RenderFillRect(mRenderer, &congratsBox);
+    mDrawBatch.FillRect(&congratsBox);
     
-    SDL_SetRenderDrawColor(mRenderer, 200, 150, 100, 255);
+    mDrawBatch.SetColor(200, 150, 100, 255);
     SDL_Rect borderRect = congratsBox;
     borderRect.x -= 5;
     borderRect.y -= 5;
@@ -324,7 +454,7 @@ void Game::DrawWinScreen() {
     borderRect.h += 10;
     
     for (int i = 0; i < 5; i++) {
-        SDL_RenderDrawRect(mRenderer, &borderRect);
+        mDrawBatch.DrawRect(&borderRect);
         borderRect.x++;
         borderRect.y++;
         borderRect.w -= 2;
@@ -341,14 +471,6 @@ void Game::DrawWinScreen() {
     RenderCenteredText("CONGRATULATIONS!", congratsTextRect, congratsColor);
     
     SDL_Color textColor = {0, 0, 0, 255};
-    std::string difficultyText;
-    switch (mSelectedDifficulty) {
-        case 1: difficultyText = "Easy"; break;
-        case 2: difficultyText = "Medium"; break;
-        case 3: difficultyText = "Hard"; break;
-        default: difficultyText = "Custom"; break;
-    }
-    
     SDL_Rect msg1Rect = {
         WINDOW_WIDTH / 2 - 150,
         WINDOW_HEIGHT / 2 - 30,
@@ -357,25 +479,6 @@ void Game::DrawWinScreen() {
     };
     RenderCenteredText("You have completed the", msg1Rect, textColor);
     
-    SDL_Rect msg2Rect = {
-        WINDOW_WIDTH / 2 - 150,
-        WINDOW_HEIGHT / 2 + 10,
-        300,
-        30
-    };
-    RenderCenteredText(difficultyText + " difficulty puzzle!", msg2Rect, textColor);
-    
-    int totalSeconds = static_cast<int>(mGameTime);
-    std::string timeText = "Time: " + FormatTime(totalSeconds);
-    
-    SDL_Rect timeRect = {
-        WINDOW_WIDTH / 2 - 100,
-        WINDOW_HEIGHT / 2 + 50,
-        200,
-        30
-    };
-    RenderCenteredText(timeText, timeRect, textColor);
-    
     SDL_Rect menuBtn = {
         WINDOW_WIDTH / 2 - 100,
         WINDOW_HEIGHT / 2 + 100,
@@ -383,23 +486,28 @@ void Game::DrawWinScreen() {
         60
     };
     
-    SDL_SetRenderDrawColor(mRenderer, 100, 200, 100, 255);
-    SDL_RenderFillRect(mRenderer, &menuBtn);
+    mDrawBatch.SetColor(100, 200, 100, 255);
+    mDrawBatch.FillRect(&menuBtn);
     
     SDL_Color btnTextColor = {0, 0, 0, 255};
     RenderCenteredText("Back to Menu", menuBtn, btnTextColor);
     
-    SDL_SetRenderDrawBlendMode(mRenderer, SDL_BLENDMODE_NONE);
+    mDrawBatch.SetBlendMode(SDL_BLENDMODE_NONE);
 }
 
 void Game::DrawGameOverScreen() {
-    SDL_SetRenderDrawBlendMode(mRenderer, SDL_BLENDMODE_BLEND);
+    SDL_Rect windowRect = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
+    DrawLayer(LayerId::GAME_OVER_SCREEN, windowRect, &Game::DrawGameOverLayer);
+}
+
+void Game::DrawGameOverLayer() {
+    mDrawBatch.SetBlendMode(SDL_BLENDMODE_BLEND);
     
-    SDL_SetRenderDrawColor(mRenderer, 120, 50, 50, 180);
+    mDrawBatch.SetColor(120, 50, 50, 180);
     SDL_Rect bgRect = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
-    SDL_RenderFillRect(mRenderer, &bgRect);
+    mDrawBatch.FillRect(&bgRect);
     
-    SDL_SetRenderDrawColor(mRenderer, 50, 50, 50, 230);
+    mDrawBatch.SetColor(50, 50, 50, 230);
     SDL_Rect gameOverBox = {
         WINDOW_WIDTH / 2 - 200,
         WINDOW_HEIGHT / 2 - 150,
@@ -407,9 +515,9 @@ void Game::DrawGameOverScreen() {
         300
     };
     
-    SDL_RenderFillRect(mRenderer, &gameOverBox);
+    mDrawBatch.FillRect(&gameOverBox);
     
-    SDL_SetRenderDrawColor(mRenderer, 150, 50, 50, 255);
+    mDrawBatch.SetColor(150, 50, 50, 255);
     SDL_Rect borderRect = gameOverBox;
     borderRect.x -= 3;
     borderRect.y -= 3;
@@ -417,7 +525,7 @@ void Game::DrawGameOverScreen() {
     borderRect.h += 6;
     
     for (int i = 0; i < 3; i++) {
-        SDL_RenderDrawRect(mRenderer, &borderRect);
+        mDrawBatch.DrawRect(&borderRect);
         borderRect.x++;
         borderRect.y++;
         borderRect.w -= 2;
@@ -440,7 +548,7 @@ void Game::DrawGameOverScreen() {
         300,
         30
     };
-    RenderCenteredText("You made " + std::to_string(MAX_MISTAKES) + " mistakes!", msg1Rect, textColor);
+    RenderCenteredText("You made " + std::to_string(GameSession::MAX_MISTAKES) + " mistakes!", msg1Rect, textColor);
     
     SDL_Rect msg2Rect = {
         WINDOW_WIDTH / 2 - 150,
@@ -457,17 +565,27 @@ void Game::DrawGameOverScreen() {
         60
     };
     
-    SDL_SetRenderDrawColor(mRenderer, 150, 50, 50, 255);
-    SDL_RenderFillRect(mRenderer, &menuBtn);
+    mDrawBatch.SetColor(150, 50, 50, 255);
+    mDrawBatch.FillRect(&menuBtn);
     
     SDL_Color btnTextColor = {255, 255, 255, 255};
     RenderCenteredText("Try Again", menuBtn, btnTextColor);
     
-    SDL_SetRenderDrawBlendMode(mRenderer, SDL_BLENDMODE_NONE);
+    mDrawBatch.SetBlendMode(SDL_BLENDMODE_NONE);
 }
 
 void Game::DrawGrid() {
-    SDL_SetRenderDrawColor(mRenderer, 0, 0, 0, 255);
+    SDL_Rect gridRect = {
+        BOARD_OFFSET_X,
+        BOARD_OFFSET_Y,
+        BOARD_SIZE + 3,
+        BOARD_SIZE + 3
+    };
+    DrawLayer(LayerId::GRID, gridRect, &Game::DrawGridLayer);
+}
+
+void Game::DrawGridLayer() {
+    mDrawBatch.SetColor(0, 0, 0, 255);
     
     for (int i = 0; i <= SudokuBoard::BOARD_SIZE; ++i) {
         int thickness = (i % 3 == 0) ? 3 : 1;
@@ -479,7 +597,7 @@ void Game::DrawGrid() {
             thickness
         };
         
-        SDL_RenderFillRect(mRenderer, &hLine);
+        mDrawBatch.FillRect(&hLine);
     }
     
     for (int i = 0; i <= SudokuBoard::BOARD_SIZE; ++i) {
@@ -492,14 +610,50 @@ void Game::DrawGrid() {
             BOARD_SIZE
         };
         
-        SDL_RenderFillRect(mRenderer, &vLine);
+        mDrawBatch.FillRect(&vLine);
+    }
+}
+
+void Game::DrawLayer(LayerId id, SDL_Rect area, void (Game::*drawStatic)()) {
+    StaticLayer& layer = mLayers[static_cast<size_t>(id)];
+    
+    if (mLayersSupported && !layer.IsValid()) {
+        mDrawBatch.Flush(mRenderer);
+        if (layer.Begin(mRenderer, area)) {
+            (this->*drawStatic)();
+            mDrawBatch.Flush(mRenderer);
+            layer.End(mRenderer);
+        } else {
+            mLayersSupported = false;
+            DestroyLayers();
+        }
+    }
+    
+    if (!mLayersSupported) {
+        (this->*drawStatic)();
+        return;
+    }
+    
+    mDrawBatch.Flush(mRenderer);
+    layer.Draw(mRenderer);
+}
+
+void Game::InvalidateLayers() {
+    for (StaticLayer& layer : mLayers) {
+        layer.Invalidate();
+    }
+}
+
+void Game::DestroyLayers() {
+    for (StaticLayer& layer : mLayers) {
+        layer.Destroy();
     }
 }
 
 void Game::DrawNumbers() {
     for (int row = 0; row < SudokuBoard::BOARD_SIZE; ++row) {
         for (int col = 0; col < SudokuBoard::BOARD_SIZE; ++col) {
-            int value = mBoard.GetCell(row, col);
+            int value = mSession.GetBoard().GetCell(row, col);
             if (value != SudokuBoard::EMPTY_CELL) {
                 SDL_Rect cellRect = {
                     BOARD_OFFSET_X + col * CELL_SIZE,
@@ -509,15 +663,15 @@ void Game::DrawNumbers() {
                 };
                 
                 SDL_Color textColor;
-                if (mBoard.IsOriginalCell(row, col)) {
+                if (mSession.GetBoard().IsOriginalCell(row, col)) {
                     textColor = {0, 0, 0, 255};
-                } else if (!mBoard.IsNumberValid(row, col)) {
+                } else if (!mSession.GetBoard().IsNumberValid(row, col)) {
                     textColor = {255, 0, 0, 255};
                 } else {
                     textColor = {0, 0, 255, 255};
                 }
                 
-                RenderCenteredText(std::to_string(value), cellRect, textColor);
+                RenderCenteredGlyphs(std::to_string(value), cellRect, textColor);
             }
         }
     }
@@ -525,7 +679,7 @@ void Game::DrawNumbers() {
 
 void Game::DrawSelection() {
     if (mSelectedRow >= 0 && mSelectedCol >= 0) {
-        SDL_SetRenderDrawColor(mRenderer, 225, 225, 225, 255);
+        mDrawBatch.SetColor(225, 225, 225, 255);
         
         SDL_Rect rowHighlight = {
             BOARD_OFFSET_X + 1,
@@ -533,7 +687,7 @@ void Game::DrawSelection() {
             BOARD_SIZE - 2,
             CELL_SIZE - 2
         };
-        SDL_RenderFillRect(mRenderer, &rowHighlight);
+        mDrawBatch.FillRect(&rowHighlight);
         
         SDL_Rect colHighlight = {
             BOARD_OFFSET_X + mSelectedCol * CELL_SIZE + 1,
@@ -541,21 +695,47 @@ void Game::DrawSelection() {
             CELL_SIZE - 2,
             BOARD_SIZE - 2
         };
-        SDL_RenderFillRect(mRenderer, &colHighlight);
+        mDrawBatch.FillRect(&colHighlight);
         
-        SDL_SetRenderDrawColor(mRenderer, 210, 210, 210, 255);
+        mDrawBatch.SetColor(210, 210, 210, 255);
         SDL_Rect cellHighlight = {
             BOARD_OFFSET_X + mSelectedCol * CELL_SIZE + 1,
             BOARD_OFFSET_Y + mSelectedRow * CELL_SIZE + 1,
             CELL_SIZE - 2,
             CELL_SIZE - 2
         };
-        SDL_RenderFillRect(mRenderer, &cellHighlight);
+        mDrawBatch.FillRect(&cellHighlight);
+    }
+}
+
+void Game::DrawConflicts() {
+    if (!mShowConflicts) {
+        return;
+    }
+    
+    const SudokuBoard::ConflictMap& conflicts = mSession.GetBoard().GetConflictMap();
+    if (conflicts.none()) {
+        return;
+    }
+    
+    mDrawBatch.SetColor(255, 200, 200, 255);
+    for (int row = 0; row < SudokuBoard::BOARD_SIZE; ++row) {
+        for (int col = 0; col < SudokuBoard::BOARD_SIZE; ++col) {
+            if (conflicts[row * SudokuBoard::BOARD_SIZE + col]) {
+                SDL_Rect cellRect = {
+                    BOARD_OFFSET_X + col * CELL_SIZE + 1,
+                    BOARD_OFFSET_Y + row * CELL_SIZE + 1,
+                    CELL_SIZE - 2,
+                    CELL_SIZE - 2
+                };
+                mDrawBatch.FillRect(&cellRect);
+            }
+        }
     }
 }
 
 void Game::DrawUI() {
-    SDL_SetRenderDrawColor(mRenderer, 200, 200, 200, 255);
+    mDrawBatch.SetColor(200, 200, 200, 255);
     
     SDL_Rect menuButton = {
         BOARD_OFFSET_X,
@@ -563,7 +743,7 @@ void Game::DrawUI() {
         150,
         50
     };
-    SDL_RenderFillRect(mRenderer, &menuButton);
+    mDrawBatch.FillRect(&menuButton);
     SDL_Color menuTextColor = {0, 0, 0, 255};
     RenderCenteredText("Menu", menuButton, menuTextColor);
     
@@ -573,14 +753,15 @@ void Game::DrawUI() {
         150,
         50
     };
-    SDL_RenderFillRect(mRenderer, &hintButton);
+    mDrawBatch.FillRect(&hintButton);
     SDL_Color hintTextColor = {0, 0, 0, 255};
     RenderCenteredText("Hint", hintButton, hintTextColor);
     
+    int mistakes = mSession.GetMistakes();
     SDL_Color mistakeColor;
-    if (mMistakes >= MAX_MISTAKES - 1) {
+    if (mistakes >= GameSession::MAX_MISTAKES - 1) {
         mistakeColor = {255, 0, 0, 255};
-    } else if (mMistakes >= MAX_MISTAKES - 2) {
+    } else if (mistakes >= GameSession::MAX_MISTAKES - 2) {
         mistakeColor = {255, 165, 0, 255};
     } else {
         mistakeColor = {0, 0, 0, 255};
@@ -593,7 +774,7 @@ void Game::DrawUI() {
         25
     };
     
-    std::string mistakeText = "Mistakes: " + std::to_string(mMistakes) + "/" + std::to_string(MAX_MISTAKES);
+    std::string mistakeText = "Mistakes: " + std::to_string(mistakes) + "/" + std::to_string(GameSession::MAX_MISTAKES);
     RenderText(mistakeText, mistakeRect.x, mistakeRect.y, mistakeColor);
 }
 
@@ -602,22 +783,15 @@ void Game::RenderText(const std::string& text, int x, int y, SDL_Color color) {
         return;
     }
     
-    SDL_Surface* textSurface = TTF_RenderText_Solid(mFont, text.c_str(), color);
-    if (!textSurface) {
-        return;
-    }
+    mDrawBatch.Flush(mRenderer);
     
-    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(mRenderer, textSurface);
-    if (!textTexture) {
-        SDL_FreeSurface(textSurface);
-        return;
+    const TextCache::Entry* cached = mTextCache.Get(mRenderer, mFont, text, color);
+    if (cached) {
+        SDL_Rect renderRect = {x, y, cached->width, cached->height};
+        SDL_RenderCopy(mRenderer, cached->texture, NULL, &renderRect);
+    } else if (mGlyphAtlas.Supports(mFont, text)) {
+        mGlyphAtlas.DrawText(mRenderer, mFont, text, x, y, color);
     }
-    
-    SDL_Rect renderRect = {x, y, textSurface->w, textSurface->h};
-    SDL_RenderCopy(mRenderer, textTexture, NULL, &renderRect);
-    
-    SDL_FreeSurface(textSurface);
-    SDL_DestroyTexture(textTexture);
 }
 
 void Game::RenderCenteredTextWithFont(const std::string& text, SDL_Rect box, SDL_Color color, TTF_Font* font) {
@@ -625,33 +799,49 @@ void Game::RenderCenteredTextWithFont(const std::string& text, SDL_Rect box, SDL
         return;
     }
     
-    SDL_Surface* textSurface = TTF_RenderText_Solid(font, text.c_str(), color);
-    if (!textSurface) {
+    mDrawBatch.Flush(mRenderer);
+    
+    const TextCache::Entry* cached = mTextCache.Get(mRenderer, font, text, color);
+    if (!cached) {
         return;
     }
     
-    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(mRenderer, textSurface);
-    if (!textTexture) {
-        SDL_FreeSurface(textSurface);
+    int x = box.x + (box.w - cached->width) / 2;
+    int y = box.y + (box.h - cached->height) / 2;
+    
+    SDL_Rect renderRect = {x, y, cached->width, cached->height};
+    SDL_RenderCopy(mRenderer, cached->texture, NULL, &renderRect);
+}
+
+void Game::RenderCenteredGlyphs(const std::string& text, SDL_Rect box, SDL_Color color) {
+    if (!mGlyphAtlas.Supports(mFont, text)) {
+        RenderCenteredText(text, box, color);
         return;
     }
     
-    int x = box.x + (box.w - textSurface->w) / 2;
-    int y = box.y + (box.h - textSurface->h) / 2;
+    mDrawBatch.Flush(mRenderer);
     
-    SDL_Rect renderRect = {x, y, textSurface->w, textSurface->h};
-    SDL_RenderCopy(mRenderer, textTexture, NULL, &renderRect);
-    
-    SDL_FreeSurface(textSurface);
-    SDL_DestroyTexture(textTexture);
+    int width, height;
+    mGlyphAtlas.MeasureText(mFont, text, width, height);
+    mGlyphAtlas.DrawText(mRenderer, mFont, text, box.x + (box.w - width) / 2, box.y + (box.h - height) / 2, color);
 }
 
 void Game::RenderCenteredText(const std::string& text, SDL_Rect box, SDL_Color color) {
     RenderCenteredTextWithFont(text, box, color, mFont);
 }
 
+void Game::RenderGlyphs(const std::string& text, int x, int y, SDL_Color color) {
+    if (!mGlyphAtlas.Supports(mFont, text)) {
+        RenderText(text, x, y, color);
+        return;
+    }
+    
+    mDrawBatch.Flush(mRenderer);
+    mGlyphAtlas.DrawText(mRenderer, mFont, text, x, y, color);
+}
+
 void Game::HandleMouseClick(int x, int y) {
-    if (mGameState == GameState::MENU) {
+    if (mSession.GetState() == GameState::MENU) {
         for (int i = 0; i < 3; ++i) {
             SDL_Rect diffBtn = {
                 WINDOW_WIDTH / 2 - 100,
@@ -676,16 +866,10 @@ void Game::HandleMouseClick(int x, int y) {
         
         if (x >= startBtn.x && x < startBtn.x + startBtn.w &&
             y >= startBtn.y && y < startBtn.y + startBtn.h) {
-            mBoard.NewGame(mSelectedDifficulty);
-            mGameState = GameState::PLAYING;
-            mSelectedRow = -1;
-            mSelectedCol = -1;
-            mMistakes = 0;
-            mGameTime = 0.0f;
-            mTimerActive = true;
+            StartNewGame();
         }
     }
-    else if (mGameState == GameState::PLAYING) {
+    else if (mSession.GetState() == GameState::PLAYING) {
         if (x >= BOARD_OFFSET_X && x < BOARD_OFFSET_X + BOARD_SIZE &&
             y >= BOARD_OFFSET_Y && y < BOARD_OFFSET_Y + BOARD_SIZE) {
             
@@ -698,19 +882,15 @@ void Game::HandleMouseClick(int x, int y) {
         else if (x >= BOARD_OFFSET_X && x < BOARD_OFFSET_X + 150 &&
                 y >= BOARD_OFFSET_Y + BOARD_SIZE + 30 && y < BOARD_OFFSET_Y + BOARD_SIZE + 80) {
             
-            mGameState = GameState::MENU;
-            mSelectedRow = -1;
-            mSelectedCol = -1;
-            mTimerActive = false;
+            ReturnToMenu();
         }
         else if (x >= BOARD_OFFSET_X + 200 && x < BOARD_OFFSET_X + 350 &&
                 y >= BOARD_OFFSET_Y + BOARD_SIZE + 30 && y < BOARD_OFFSET_Y + BOARD_SIZE + 80) {
             
             int hintRow, hintCol, hintValue;
-            if (mBoard.GetHint(hintRow, hintCol, hintValue)) {
+            if (mSession.ApplyHint(hintRow, hintCol, hintValue)) {
                 mSelectedRow = hintRow;
                 mSelectedCol = hintCol;
-                mBoard.SetCell(hintRow, hintCol, hintValue);
             }
         }
         else {
@@ -718,7 +898,7 @@ void Game::HandleMouseClick(int x, int y) {
             mSelectedCol = -1;
         }
     }
-    else if (mGameState == GameState::WIN) {
+    else if (mSession.GetState() == GameState::WIN) {
         SDL_Rect menuBtn = {
             WINDOW_WIDTH / 2 - 100,
             WINDOW_HEIGHT / 2 + 80,
@@ -728,10 +908,10 @@ void Game::HandleMouseClick(int x, int y) {
         
         if (x >= menuBtn.x - 20 && x < menuBtn.x + menuBtn.w + 20 &&
             y >= menuBtn.y && y < menuBtn.y + menuBtn.h) {
-            mGameState = GameState::MENU;
+            ReturnToMenu();
         }
     }
-    else if (mGameState == GameState::GAME_OVER) {
+    else if (mSession.GetState() == GameState::GAME_OVER) {
         SDL_Rect menuBtn = {
             WINDOW_WIDTH / 2 - 100,
             WINDOW_HEIGHT / 2 + 80,
@@ -741,7 +921,7 @@ void Game::HandleMouseClick(int x, int y) {
         
         if (x >= menuBtn.x - 20 && x < menuBtn.x + menuBtn.w + 20 &&
             y >= menuBtn.y && y < menuBtn.y + menuBtn.h) {
-            mGameState = GameState::MENU;
+            ReturnToMenu();
         }
     }
 }
@@ -764,16 +944,53 @@ void Game::DrawTimer() {
         30
     };
     
-    SDL_SetRenderDrawColor(mRenderer, 200, 200, 200, 255);
-    SDL_RenderFillRect(mRenderer, &timerBg);
+    mDrawBatch.SetColor(200, 200, 200, 255);
+    mDrawBatch.FillRect(&timerBg);
     
-    SDL_SetRenderDrawColor(mRenderer, 100, 100, 100, 255);
+    mDrawBatch.SetColor(100, 100, 100, 255);
     SDL_Rect timerBorder = timerBg;
-    SDL_RenderDrawRect(mRenderer, &timerBorder);
+    mDrawBatch.DrawRect(&timerBorder);
     
-    int totalSeconds = static_cast<int>(mGameTime);
+    int totalSeconds = static_cast<int>(mSession.GetElapsedTime());
     std::string timerText = FormatTime(totalSeconds);
     
     SDL_Color textColor = {0, 0, 0, 255};
-    RenderCenteredText(timerText, timerBg, textColor);
-} 
\ No newline at end of file
+    RenderCenteredGlyphs(timerText, timerBg, textColor);
+} 
+
+void Game::DrawProfilerHud() {
+    if (!mProfiler.IsEnabled()) {
+        return;
+    }
+    
+    const char* phaseNames[] = {"Input", "Update", "Render", "Present"};
+    const int lineHeight = 28;
+    
+    SDL_Rect panel = {5, 5, WINDOW_WIDTH - 10, lineHeight * 6 + 10};
+    mDrawBatch.SetBlendMode(SDL_BLENDMODE_BLEND);
+    mDrawBatch.SetColor(0, 0, 0, 190);
+    mDrawBatch.FillRect(&panel);
+    mDrawBatch.SetBlendMode(SDL_BLENDMODE_NONE);
+    
+    SDL_Color textColor = {255, 255, 255, 255};
+    int x = panel.x + 8;
+    int y = panel.y + 5;
+    char line[96];
+    
+    SDL_snprintf(line, sizeof(line), "ms         p50    p95    p99    (%u frames)",
+        static_cast<unsigned>(std::min<uint64_t>(mProfiler.GetFrameCount(), FrameProfiler::WINDOW_SIZE)));
+    RenderGlyphs(line, x, y, textColor);
+    
+    for (size_t i = 0; i < FrameProfiler::PHASE_COUNT; ++i) {
+        float p50, p95, p99;
+        mProfiler.GetPercentiles(static_cast<FramePhase>(i), p50, p95, p99);
+        SDL_snprintf(line, sizeof(line), "%-9s %6.2f %6.2f %6.2f", phaseNames[i], p50, p95, p99);
+        y += lineHeight;
+        RenderGlyphs(line, x, y, textColor);
+    }
+    
+    const DrawStats& stats = mDrawBatch.GetLastFrameStats();
+    SDL_snprintf(line, sizeof(line), "Draw calls: %d  Rects: %d", stats.drawCalls, stats.rects);
+    y += lineHeight;
+    RenderGlyphs(line, x, y, textColor);
+}
@@ -0,0 +1,144 @@
+#include "GameSession.h"
+
+GameSession::GameSession()
+    : mState(GameState::MENU)
+    , mDifficulty(0)
+    , mMistakes(0)
+    , mElapsedTime(0.0f)
+    , mStateTime(0.0f)
+    , mTimerActive(false)
+    , mMoveCount(0)
+{
+    mBoard.SetSolvedCallback([this]() { OnBoardSolved(); });
+}
+
+void GameSession::Start(int difficulty) {
+    mBoard.NewGame(difficulty);
+    BeginPlaying(difficulty);
+}
+
+void GameSession::Start(const GeneratedPuzzle& puzzle) {
+    mBoard.LoadGeneratedPuzzle(puzzle);
+    BeginPlaying(puzzle.difficulty);
+}
+
+bool GameSession::StartFromId(uint64_t id) {
+    if (!mBoard.NewGameFromId(id)) {
+        return false;
+    }
+    BeginPlaying(mBoard.GetDifficulty());
+    return true;
+}
+
+void GameSession::ReturnToMenu() {
+    mState = GameState::MENU;
+    mStateTime = 0.0f;
+    mTimerActive = false;
+}
+
+void GameSession::Update(float deltaTime) {
+    mStateTime += deltaTime;
+
+    if (mTimerActive && mState == GameState::PLAYING) {
+        mElapsedTime += deltaTime;
+    }
+}
+
+MoveResult GameSession::EnterNumber(int row, int col, int value) {
+    if (mState != GameState::PLAYING || mBoard.IsOriginalCell(row, col)) {
+        return MoveResult::REJECTED;
+    }
+
+    ++mMoveCount;
+
+    if (!mBoard.IsValidMove(row, col, value)) {
+        AddMistake();
+        return MoveResult::MISTAKE;
+    }
+
+    mBoard.SetCell(row, col, value);
+    return MoveResult::PLACED;
+}
+
+MoveResult GameSession::ClearEntry(int row, int col) {
+    if (mState != GameState::PLAYING || mBoard.IsOriginalCell(row, col)) {
+        return MoveResult::REJECTED;
+    }
+
+    ++mMoveCount;
+    mBoard.ClearCell(row, col);
+    return MoveResult::CLEARED;
+}
+
+bool GameSession::ApplyHint(int& row, int& col, int& value) {
+    if (mState != GameState::PLAYING || !mBoard.GetHint(row, col, value)) {
+        return false;
+    }
+
+    ++mMoveCount;
+    mBoard.SetCell(row, col, value);
+    return true;
+}
+
+GameState GameSession::GetState() const {
+    return mState;
+}
+
+int GameSession::GetDifficulty() const {
+    return mDifficulty;
+}
+
+int GameSession::GetMistakes() const {
+    return mMistakes;
+}
+
+float GameSession::GetElapsedTime() const {
+    return mElapsedTime;
+}
+
+bool GameSession::IsTimerActive() const {
+    return mTimerActive;
+}
+
+float GameSession::GetStateTime() const {
+    return mStateTime;
+}
+
+uint64_t GameSession::GetMoveCount() const {
+    return mMoveCount;
+}
+
+const SudokuBoard& GameSession::GetBoard() const {
+    return mBoard;
+}
+
+SudokuBoard& GameSession::GetBoard() {
+    return mBoard;
+}
+
+void GameSession::BeginPlaying(int difficulty) {
+    mState = GameState::PLAYING;
+    mDifficulty = difficulty;
+    mMistakes = 0;
+    mElapsedTime = 0.0f;
+    mStateTime = 0.0f;
+    mTimerActive = true;
+}
+
+void GameSession::AddMistake() {
+    mMistakes++;
+
+    if (mMistakes >= MAX_MISTAKES) {
+        mState = GameState::GAME_OVER;
+        mStateTime = 0.0f;
+        mTimerActive = false;
+    }
+}
+
+void GameSession::OnBoardSolved() {
+    if (mState == GameState::PLAYING) {
+        mState = GameState::WIN;
+        mStateTime = 0.0f;
+        mTimerActive = false;
+    }
+}
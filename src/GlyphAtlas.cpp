@@ -0,0 +1,193 @@
+#include "GlyphAtlas.h"
+
+GlyphAtlas::GlyphAtlas()
+    : mTexture(nullptr)
+{
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    Destroy();
+}
+
+bool GlyphAtlas::Build(SDL_Renderer* renderer, const std::vector<TTF_Font*>& fonts) {
+    Destroy();
+
+    SDL_Color white = {255, 255, 255, 255};
+    std::vector<SDL_Surface*> surfaces;
+    surfaces.reserve(fonts.size() * GLYPH_COUNT);
+
+    int x = 0;
+    int y = 0;
+    int shelfHeight = 0;
+    bool ok = true;
+
+    for (TTF_Font* font : fonts) {
+        FontGlyphs entry;
+        entry.font = font;
+        entry.height = TTF_FontHeight(font);
+        entry.kerning = TTF_GetFontKerning(font) != 0;
+
+        for (int i = 0; i < GLYPH_COUNT; ++i) {
+            Uint16 ch = static_cast<Uint16>(FIRST_GLYPH + i);
+            Glyph& glyph = entry.glyphs[i];
+            glyph.source = {0, 0, 0, 0};
+            glyph.advance = 0;
+
+            int minX, maxX, minY, maxY;
+            if (TTF_GlyphMetrics(font, ch, &minX, &maxX, &minY, &maxY, &glyph.advance) != 0) {
+                glyph.advance = 0;
+            }
+
+            SDL_Surface* surface = TTF_RenderGlyph_Solid(font, ch, white);
+            surfaces.push_back(surface);
+            if (!surface) {
+                if (ch != ' ') {
+                    ok = false;
+                }
+                continue;
+            }
+
+            if (x + surface->w > ATLAS_WIDTH) {
+                x = 0;
+                y += shelfHeight + GLYPH_PADDING;
+                shelfHeight = 0;
+            }
+
+            glyph.source = {x, y, surface->w, surface->h};
+            x += surface->w + GLYPH_PADDING;
+            if (surface->h > shelfHeight) {
+                shelfHeight = surface->h;
+            }
+        }
+
+        mFonts.push_back(entry);
+    }
+
+    SDL_Surface* atlas = nullptr;
+    if (ok) {
+        atlas = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_WIDTH, y + shelfHeight, 32, SDL_PIXELFORMAT_ARGB8888);
+    }
+
+    if (atlas) {
+        SDL_FillRect(atlas, nullptr, SDL_MapRGBA(atlas->format, 0, 0, 0, 0));
+
+        size_t index = 0;
+        for (FontGlyphs& entry : mFonts) {
+            for (Glyph& glyph : entry.glyphs) {
+                SDL_Surface* surface = surfaces[index++];
+                if (surface) {
+                    SDL_Rect target = glyph.source;
+                    SDL_BlitSurface(surface, nullptr, atlas, &target);
+                }
+            }
+        }
+
+        mTexture = SDL_CreateTextureFromSurface(renderer, atlas);
+        SDL_FreeSurface(atlas);
+    }
+
+    for (SDL_Surface* surface : surfaces) {
+        if (surface) {
+            SDL_FreeSurface(surface);
+        }
+    }
+
+    if (!mTexture) {
+        mFonts.clear();
+        return false;
+    }
+
+    SDL_SetTextureBlendMode(mTexture, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+void GlyphAtlas::Destroy() {
+    if (mTexture) {
+        SDL_DestroyTexture(mTexture);
+        mTexture = nullptr;
+    }
+    mFonts.clear();
+}
+
+bool GlyphAtlas::Supports(TTF_Font* font, const std::string& text) const {
+    if (!FindFont(font)) {
+        return false;
+    }
+
+    for (char c : text) {
+        if (c < FIRST_GLYPH || c > LAST_GLYPH) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void GlyphAtlas::MeasureText(TTF_Font* font, const std::string& text, int& width, int& height) const {
+    width = 0;
+    height = 0;
+
+    const FontGlyphs* entry = FindFont(font);
+    if (!entry) {
+        return;
+    }
+
+    int pen = 0;
+    char previous = 0;
+    for (char c : text) {
+        const Glyph& glyph = entry->glyphs[c - FIRST_GLYPH];
+        pen += Kerning(*entry, previous, c);
+        if (pen + glyph.source.w > width) {
+            width = pen + glyph.source.w;
+        }
+        pen += glyph.advance;
+        previous = c;
+    }
+
+    if (pen > width) {
+        width = pen;
+    }
+    height = entry->height;
+}
+
+void GlyphAtlas::DrawText(SDL_Renderer* renderer, TTF_Font* font, const std::string& text, int x, int y, SDL_Color color) const {
+    const FontGlyphs* entry = FindFont(font);
+    if (!entry) {
+        return;
+    }
+
+    SDL_SetTextureColorMod(mTexture, color.r, color.g, color.b);
+    SDL_SetTextureAlphaMod(mTexture, color.a);
+
+    int pen = x;
+    char previous = 0;
+    for (char c : text) {
+        const Glyph& glyph = entry->glyphs[c - FIRST_GLYPH];
+        pen += Kerning(*entry, previous, c);
+        if (glyph.source.w > 0) {
+            SDL_Rect target = {pen, y, glyph.source.w, glyph.source.h};
+            SDL_RenderCopy(renderer, mTexture, &glyph.source, &target);
+        }
+        pen += glyph.advance;
+        previous = c;
+    }
+}
+
+const GlyphAtlas::FontGlyphs* GlyphAtlas::FindFont(TTF_Font* font) const {
+    if (!mTexture || !font) {
+        return nullptr;
+    }
+
+    for (const FontGlyphs& entry : mFonts) {
+        if (entry.font == font) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+int GlyphAtlas::Kerning(const FontGlyphs& glyphs, char previous, char current) {
+    if (!glyphs.kerning || previous == 0) {
+        return 0;
+    }
+    return TTF_GetFontKerningSizeGlyphs(glyphs.font, static_cast<Uint16>(previous), static_cast<Uint16>(current));
+}
@@ -0,0 +1,575 @@
+#include "Grader.h"
+#include "BitUtils.h"
+#include <cstring>
+
+namespace {
+
+const int BOARD_SIZE = Solver::BOARD_SIZE;
+const int BOX_SIZE = Solver::BOX_SIZE;
+const int CELL_COUNT = BOARD_SIZE * BOARD_SIZE;
+const int UNIT_COUNT = BOARD_SIZE * 3;
+const int PEER_COUNT = 20;
+const uint16_t ALL_CANDIDATES = (1u << BOARD_SIZE) - 1;
+
+struct TechniqueInfo {
+    const char* name;
+    int weight;
+};
+
+const TechniqueInfo kTechniques[static_cast<int>(Technique::COUNT)] = {
+    {"none", 0},
+    {"hidden_single", 1},
+    {"naked_single", 2},
+    {"locked_candidates", 8},
+    {"naked_pair", 15},
+    {"hidden_pair", 20},
+    {"naked_triple", 25},
+    {"hidden_triple", 30},
+    {"x_wing", 40},
+    {"swordfish", 60},
+    {"xy_wing", 70},
+    {"chain", 100},
+    {"guessing", 500}
+};
+
+struct Tables {
+    std::array<std::array<uint8_t, BOARD_SIZE>, UNIT_COUNT> units;
+    std::array<std::array<uint8_t, PEER_COUNT>, CELL_COUNT> peers;
+    std::array<uint8_t, CELL_COUNT> rows;
+    std::array<uint8_t, CELL_COUNT> cols;
+    std::array<uint8_t, CELL_COUNT> boxes;
+};
+
+const Tables& GetTables() {
+    static const Tables tables = [] {
+        Tables result;
+        for (int cell = 0; cell < CELL_COUNT; ++cell) {
+            result.rows[cell] = static_cast<uint8_t>(cell / BOARD_SIZE);
+            result.cols[cell] = static_cast<uint8_t>(cell % BOARD_SIZE);
+            result.boxes[cell] = static_cast<uint8_t>(Solver::BoxIndex(cell / BOARD_SIZE, cell % BOARD_SIZE));
+        }
+
+        for (int i = 0; i < BOARD_SIZE; ++i) {
+            for (int j = 0; j < BOARD_SIZE; ++j) {
+                int boxRow = (i / BOX_SIZE) * BOX_SIZE + j / BOX_SIZE;
+                int boxCol = (i % BOX_SIZE) * BOX_SIZE + j % BOX_SIZE;
+                result.units[i][j] = static_cast<uint8_t>(i * BOARD_SIZE + j);
+                result.units[BOARD_SIZE + i][j] = static_cast<uint8_t>(j * BOARD_SIZE + i);
+                result.units[2 * BOARD_SIZE + i][j] = static_cast<uint8_t>(boxRow * BOARD_SIZE + boxCol);
+            }
+        }
+
+        for (int cell = 0; cell < CELL_COUNT; ++cell) {
+            int count = 0;
+            for (int other = 0; other < CELL_COUNT; ++other) {
+                if (other != cell && (result.rows[other] == result.rows[cell] ||
+                    result.cols[other] == result.cols[cell] || result.boxes[other] == result.boxes[cell])) {
+                    result.peers[cell][count++] = static_cast<uint8_t>(other);
+                }
+            }
+        }
+        return result;
+    }();
+    return tables;
+}
+
+struct State {
+    std::array<uint8_t, CELL_COUNT> values;
+    std::array<uint16_t, CELL_COUNT> candidates;
+    int empty;
+    bool broken;
+};
+
+uint16_t DigitBit(int value) {
+    return static_cast<uint16_t>(1u << (value - 1));
+}
+
+bool Sees(const Tables& tables, int a, int b) {
+    return a != b && (tables.rows[a] == tables.rows[b] || tables.cols[a] == tables.cols[b] ||
+        tables.boxes[a] == tables.boxes[b]);
+}
+
+struct PendingCells {
+    std::array<uint8_t, 2 * CELL_COUNT> cells;
+    int count = 0;
+};
+
+void Place(State& state, int cell, int value, PendingCells* pending = nullptr) {
+    const Tables& tables = GetTables();
+    uint16_t bit = DigitBit(value);
+    state.values[cell] = static_cast<uint8_t>(value);
+    state.candidates[cell] = 0;
+    --state.empty;
+    for (uint8_t peer : tables.peers[cell]) {
+        uint16_t candidates = state.candidates[peer];
+        if (!(candidates & bit)) {
+            continue;
+        }
+        candidates = static_cast<uint16_t>(candidates & ~bit);
+        state.candidates[peer] = candidates;
+        if (pending && CountBits(candidates) <= 1) {
+            pending->cells[pending->count++] = peer;
+        }
+    }
+}
+
+bool Eliminate(State& state, int cell, uint16_t mask) {
+    uint16_t before = state.candidates[cell];
+    state.candidates[cell] = static_cast<uint16_t>(before & ~mask);
+    return state.candidates[cell] != before;
+}
+
+bool ApplyNakedSingles(State& state, bool all) {
+    bool progress = false;
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        if (state.values[cell] != 0) {
+            continue;
+        }
+        uint16_t candidates = state.candidates[cell];
+        if (candidates == 0) {
+            state.broken = true;
+            return false;
+        }
+        if (CountBits(candidates) == 1) {
+            Place(state, cell, LowestBitIndex(candidates) + 1);
+            progress = true;
+            if (!all) {
+                return true;
+            }
+        }
+    }
+    return progress;
+}
+
+bool ApplyHiddenSingles(State& state, bool all, PendingCells* pending = nullptr) {
+    const Tables& tables = GetTables();
+    bool progress = false;
+
+    for (const auto& unit : tables.units) {
+        uint16_t once = 0;
+        uint16_t twice = 0;
+        uint16_t placed = 0;
+        for (uint8_t cell : unit) {
+            if (state.values[cell] != 0) {
+                placed |= DigitBit(state.values[cell]);
+            } else {
+                twice |= once & state.candidates[cell];
+                once |= state.candidates[cell];
+            }
+        }
+        if ((once | placed) != ALL_CANDIDATES) {
+            state.broken = true;
+            return false;
+        }
+
+        uint16_t singles = static_cast<uint16_t>(once & ~twice);
+        while (singles) {
+            uint16_t bit = static_cast<uint16_t>(singles & (0u - singles));
+            singles &= static_cast<uint16_t>(singles - 1);
+            for (uint8_t cell : unit) {
+                if (state.candidates[cell] & bit) {
+                    Place(state, cell, LowestBitIndex(bit) + 1, pending);
+                    progress = true;
+                    break;
+                }
+            }
+            if (progress && !all) {
+                return true;
+            }
+        }
+    }
+    return progress;
+}
+
+template <typename Visit>
+bool VisitSubsets(const uint16_t* masks, int count, int size, int start, uint16_t items, uint16_t cover, Visit& visit) {
+    int chosen = CountBits(items);
+    if (chosen == size) {
+        return CountBits(cover) == size && visit(items, cover);
+    }
+
+    for (int i = start; i <= count - (size - chosen); ++i) {
+        if (masks[i] == 0) {
+            continue;
+        }
+        uint16_t next = static_cast<uint16_t>(cover | masks[i]);
+        if (CountBits(next) > size) {
+            continue;
+        }
+        if (VisitSubsets(masks, count, size, i + 1, static_cast<uint16_t>(items | (1u << i)), next, visit)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int CountNonZero(const uint16_t* masks, int count) {
+    int result = 0;
+    for (int i = 0; i < count; ++i) {
+        result += masks[i] != 0 ? 1 : 0;
+    }
+    return result;
+}
+
+bool ApplyLockedCandidates(State& state) {
+    const Tables& tables = GetTables();
+
+    for (int box = 0; box < BOARD_SIZE; ++box) {
+        const auto& unit = tables.units[2 * BOARD_SIZE + box];
+        for (int digit = 0; digit < BOARD_SIZE; ++digit) {
+            uint16_t bit = static_cast<uint16_t>(1u << digit);
+            uint16_t rows = 0;
+            uint16_t cols = 0;
+            for (uint8_t cell : unit) {
+                if (state.candidates[cell] & bit) {
+                    rows |= static_cast<uint16_t>(1u << tables.rows[cell]);
+                    cols |= static_cast<uint16_t>(1u << tables.cols[cell]);
+                }
+            }
+
+            bool changed = false;
+            if (CountBits(rows) == 1) {
+                for (uint8_t cell : tables.units[LowestBitIndex(rows)]) {
+                    if (tables.boxes[cell] != box) {
+                        changed |= Eliminate(state, cell, bit);
+                    }
+                }
+            }
+            if (CountBits(cols) == 1) {
+                for (uint8_t cell : tables.units[BOARD_SIZE + LowestBitIndex(cols)]) {
+                    if (tables.boxes[cell] != box) {
+                        changed |= Eliminate(state, cell, bit);
+                    }
+                }
+            }
+            if (changed) {
+                return true;
+            }
+        }
+    }
+
+    for (int line = 0; line < 2 * BOARD_SIZE; ++line) {
+        const auto& unit = tables.units[line];
+        for (int digit = 0; digit < BOARD_SIZE; ++digit) {
+            uint16_t bit = static_cast<uint16_t>(1u << digit);
+            uint16_t boxes = 0;
+            for (uint8_t cell : unit) {
+                if (state.candidates[cell] & bit) {
+                    boxes |= static_cast<uint16_t>(1u << tables.boxes[cell]);
+                }
+            }
+            if (CountBits(boxes) != 1) {
+                continue;
+            }
+
+            bool changed = false;
+            for (uint8_t cell : tables.units[2 * BOARD_SIZE + LowestBitIndex(boxes)]) {
+                bool inLine = line < BOARD_SIZE ? tables.rows[cell] == line : tables.cols[cell] == line - BOARD_SIZE;
+                if (!inLine) {
+                    changed |= Eliminate(state, cell, bit);
+                }
+            }
+            if (changed) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool ApplyNakedSubset(State& state, int size) {
+    const Tables& tables = GetTables();
+
+    for (const auto& unit : tables.units) {
+        uint16_t masks[BOARD_SIZE];
+        for (int i = 0; i < BOARD_SIZE; ++i) {
+            masks[i] = state.candidates[unit[i]];
+        }
+        if (CountNonZero(masks, BOARD_SIZE) <= size) {
+            continue;
+        }
+
+        auto visit = [&](uint16_t items, uint16_t cover) {
+            bool changed = false;
+            for (int i = 0; i < BOARD_SIZE; ++i) {
+                if (!(items & (1u << i)) && masks[i] != 0) {
+                    changed |= Eliminate(state, unit[i], cover);
+                }
+            }
+            return changed;
+        };
+        if (VisitSubsets(masks, BOARD_SIZE, size, 0, 0, 0, visit)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ApplyHiddenSubset(State& state, int size) {
+    const Tables& tables = GetTables();
+
+    for (const auto& unit : tables.units) {
+        uint16_t positions[BOARD_SIZE] = {};
+        for (int i = 0; i < BOARD_SIZE; ++i) {
+            uint16_t candidates = state.candidates[unit[i]];
+            for (int digit = 0; digit < BOARD_SIZE; ++digit) {
+                if (candidates & (1u << digit)) {
+                    positions[digit] |= static_cast<uint16_t>(1u << i);
+                }
+            }
+        }
+        if (CountNonZero(positions, BOARD_SIZE) <= size) {
+            continue;
+        }
+
+        auto visit = [&](uint16_t digits, uint16_t cover) {
+            bool changed = false;
+            for (int i = 0; i < BOARD_SIZE; ++i) {
+                if (cover & (1u << i)) {
+                    changed |= Eliminate(state, unit[i], static_cast<uint16_t>(ALL_CANDIDATES & ~digits));
+                }
+            }
+            return changed;
+        };
+        if (VisitSubsets(positions, BOARD_SIZE, size, 0, 0, 0, visit)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ApplyFish(State& state, int size) {
+    for (int digit = 0; digit < BOARD_SIZE; ++digit) {
+        uint16_t bit = static_cast<uint16_t>(1u << digit);
+        for (int byRows = 0; byRows < 2; ++byRows) {
+            uint16_t masks[BOARD_SIZE] = {};
+            for (int line = 0; line < BOARD_SIZE; ++line) {
+                for (int cross = 0; cross < BOARD_SIZE; ++cross) {
+                    int cell = byRows ? line * BOARD_SIZE + cross : cross * BOARD_SIZE + line;
+                    if (state.candidates[cell] & bit) {
+                        masks[line] |= static_cast<uint16_t>(1u << cross);
+                    }
+                }
+            }
+            if (CountNonZero(masks, BOARD_SIZE) <= size) {
+                continue;
+            }
+
+            auto visit = [&](uint16_t lines, uint16_t cover) {
+                bool changed = false;
+                for (int line = 0; line < BOARD_SIZE; ++line) {
+                    if (lines & (1u << line)) {
+                        continue;
+                    }
+                    for (int cross = 0; cross < BOARD_SIZE; ++cross) {
+                        if (cover & (1u << cross)) {
+                            int cell = byRows ? line * BOARD_SIZE + cross : cross * BOARD_SIZE + line;
+                            changed |= Eliminate(state, cell, bit);
+                        }
+                    }
+                }
+                return changed;
+            };
+            if (VisitSubsets(masks, BOARD_SIZE, size, 0, 0, 0, visit)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool ApplyXyWing(State& state) {
+    const Tables& tables = GetTables();
+
+    for (int pivot = 0; pivot < CELL_COUNT; ++pivot) {
+        uint16_t pivotMask = state.candidates[pivot];
+        if (CountBits(pivotMask) != 2) {
+            continue;
+        }
+
+        for (uint8_t first : tables.peers[pivot]) {
+            uint16_t firstMask = state.candidates[first];
+            if (CountBits(firstMask) != 2 || CountBits(firstMask & pivotMask) != 1) {
+                continue;
+            }
+            uint16_t target = static_cast<uint16_t>(firstMask & ~pivotMask);
+            uint16_t secondMask = static_cast<uint16_t>((pivotMask & ~firstMask) | target);
+
+            for (uint8_t second : tables.peers[pivot]) {
+                if (second == first || state.candidates[second] != secondMask) {
+                    continue;
+                }
+
+                bool changed = false;
+                for (uint8_t cell : tables.peers[first]) {
+                    if (cell != pivot && Sees(tables, cell, second)) {
+                        changed |= Eliminate(state, cell, target);
+                    }
+                }
+                if (changed) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void PropagateSingles(State& state, int cell, int value) {
+    PendingCells pending;
+    Place(state, cell, value, &pending);
+
+    while (true) {
+        while (pending.count > 0) {
+            int next = pending.cells[--pending.count];
+            if (state.values[next] != 0) {
+                continue;
+            }
+            uint16_t candidates = state.candidates[next];
+            if (candidates == 0) {
+                state.broken = true;
+                return;
+            }
+            Place(state, next, LowestBitIndex(candidates) + 1, &pending);
+        }
+
+        if (state.empty == 0 || !ApplyHiddenSingles(state, true, &pending)) {
+            return;
+        }
+    }
+}
+
+bool ApplyChain(State& state) {
+    std::array<uint16_t, CELL_COUNT> forced;
+    forced.fill(ALL_CANDIDATES);
+
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        uint16_t candidates = state.candidates[cell];
+        if (CountBits(candidates) != 2) {
+            continue;
+        }
+        int first = LowestBitIndex(candidates) + 1;
+        int second = LowestBitIndex(candidates & (candidates - 1)) + 1;
+
+        State left = state;
+        PropagateSingles(left, cell, first);
+        if (left.broken) {
+            forced[cell] &= DigitBit(second);
+            continue;
+        }
+
+        State right = state;
+        PropagateSingles(right, cell, second);
+        if (right.broken) {
+            forced[cell] &= DigitBit(first);
+            continue;
+        }
+
+        for (int other = 0; other < CELL_COUNT; ++other) {
+            if (state.values[other] == 0 && left.values[other] != 0 && left.values[other] == right.values[other]) {
+                forced[other] &= DigitBit(left.values[other]);
+            }
+        }
+    }
+
+    bool changed = false;
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        if (state.values[cell] == 0) {
+            changed |= Eliminate(state, cell, static_cast<uint16_t>(ALL_CANDIDATES & ~forced[cell]));
+        }
+    }
+    return changed;
+}
+
+bool ApplyTechnique(Technique technique, State& state) {
+    switch (technique) {
+        case Technique::HIDDEN_SINGLE: return ApplyHiddenSingles(state, false);
+        case Technique::NAKED_SINGLE: return ApplyNakedSingles(state, false);
+        case Technique::LOCKED_CANDIDATES: return ApplyLockedCandidates(state);
+        case Technique::NAKED_PAIR: return ApplyNakedSubset(state, 2);
+        case Technique::HIDDEN_PAIR: return ApplyHiddenSubset(state, 2);
+        case Technique::NAKED_TRIPLE: return ApplyNakedSubset(state, 3);
+        case Technique::HIDDEN_TRIPLE: return ApplyHiddenSubset(state, 3);
+        case Technique::X_WING: return ApplyFish(state, 2);
+        case Technique::SWORDFISH: return ApplyFish(state, 3);
+        case Technique::XY_WING: return ApplyXyWing(state);
+        case Technique::CHAIN: return ApplyChain(state);
+        default: return false;
+    }
+}
+
+void Record(PuzzleGrade& grade, Technique technique) {
+    ++grade.steps[static_cast<size_t>(technique)];
+    grade.score += Grader::GetWeight(technique);
+    if (technique > grade.hardest) {
+        grade.hardest = technique;
+    }
+}
+
+}
+
+bool Grader::Grade(const Solver::Grid& givens, PuzzleGrade& grade) {
+    grade = PuzzleGrade();
+
+    State state;
+    state.values.fill(0);
+    state.candidates.fill(ALL_CANDIDATES);
+    state.empty = CELL_COUNT;
+    state.broken = false;
+
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        int value = givens[cell / BOARD_SIZE][cell % BOARD_SIZE];
+        if (value == Solver::EMPTY_CELL) {
+            continue;
+        }
+        if (value < 1 || value > BOARD_SIZE || !(state.candidates[cell] & DigitBit(value))) {
+            return false;
+        }
+        Place(state, cell, value);
+    }
+
+    while (state.empty > 0) {
+        Technique applied = Technique::NONE;
+        for (int t = static_cast<int>(Technique::HIDDEN_SINGLE); t < static_cast<int>(Technique::GUESSING); ++t) {
+            bool progress = ApplyTechnique(static_cast<Technique>(t), state);
+            if (state.broken) {
+                return false;
+            }
+            if (progress) {
+                applied = static_cast<Technique>(t);
+                break;
+            }
+        }
+
+        if (applied == Technique::NONE) {
+            Record(grade, Technique::GUESSING);
+            break;
+        }
+        Record(grade, applied);
+    }
+    return true;
+}
+
+int Grader::GetWeight(Technique technique) {
+    if (technique < Technique::NONE || technique >= Technique::COUNT) {
+        return 0;
+    }
+    return kTechniques[static_cast<int>(technique)].weight;
+}
+
+const char* Grader::GetName(Technique technique) {
+    if (technique < Technique::NONE || technique >= Technique::COUNT) {
+        return "unknown";
+    }
+    return kTechniques[static_cast<int>(technique)].name;
+}
+
+bool Grader::ParseName(const char* name, Technique& technique) {
+    for (int t = 0; t < static_cast<int>(Technique::COUNT); ++t) {
+        if (std::strcmp(name, kTechniques[t].name) == 0) {
+            technique = static_cast<Technique>(t);
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,125 @@
+#include "GridGenerator.h"
+#include <array>
+
+namespace {
+
+const char* const kBaseGrids[GridGenerator::BASE_GRID_COUNT] = {
+    "285916743461375298937842561178654932529731486643298157716489325854123679392567814",
+    "418795236567231489329486571246853197951627348873149625734518962182964753695372814",
+    "165324987827965143493718562354187296712649358986532714249871635671453829538296471",
+    "958624173634871295271395468846257319319486752527913846195732684762548931483169527",
+    "927135486651984237348267159734851962192346875865729341286593714579418623413672598",
+    "681342579327965184594187632839514726165728493472639815946271358753896241218453967",
+    "643219587719385246528764913264157398381692475957843162435976821896521734172438659",
+    "829465137563719248417832659982146375745283916631597824376924581194358762258671493",
+    "896172345754369821213548769627934518145786293938215674469823157372451986581697432",
+    "542738691317965824869412735135286947978143256426597318693851472754629183281374569",
+    "538461297642397851917852643165784329279513486483926175721645938854139762396278514",
+    "976183524345267189128459367659324871284671935731895642867912453412538796593746218",
+    "124937658356821947798456213815792436637145829249683571963514782581279364472368195",
+    "783915246512634789649287135836149572271853964954726813168492357425371698397568421",
+    "134925687892617435675834921759243168346178592218596743587369214923451876461782359",
+    "681234579375619842492875316726183495814957623953462187237548961568791234149326758",
+    "935284716476351829218769354784695231521843697693127485852416973349578162167932548",
+    "638419275124657893597238416769821534213594768845763921371985642486372159952146387",
+    "481359762953726418627841359745682931296413587318597246174238695832965174569174823",
+    "258674319491328675376915482187236594942857136635491827724163958819542763563789241",
+    "514389672327516849869472531283947156975621483641853927738195264492768315156234798",
+    "518426973263795481794381562935864217826517394471239856652973148347158629189642735",
+    "348952176256371489971648352763129548194865723825437691517293864439786215682514937",
+    "365921748219478536874563129523794861947186253681352497156237984732849615498615372",
+    "546391287731482596829576413192758364458623179673914852984265731265137948317849625",
+    "942378561831654792576129843465817329127936485389245617298563174654791238713482956",
+    "264513879798642315513897246687354192432169587951728463345986721126475938879231654",
+    "361859427572164398984273615143798562856412973729635184217346859635987241498521736",
+    "469732851815469723372518469653891274724356198198274635947683512236145987581927346",
+    "127856349865934217394127568631785492472693851958241736283469175749512683516378924",
+    "469185327718432695253769418876321549134597286925846173681273954597614832342958761",
+    "694127538158639247372584169761843925845291376239765814483972651526418793917356482",
+    "168472395247593168953861427326947581419285673785316249672159834534728916891634752",
+    "598427163162853497473961285839145672245678319617392854921536748784219536356784921",
+    "598463127142897356736251948379128465254976813681534792827619534415382679963745281",
+    "653412789942687513871539426324875691516923874789146352138794265267351948495268137",
+    "879316542645872139123495687764539218381724956592168374456981723938257461217643895",
+    "965832147432791658718546239583429761697315482241687395826973514154268973379154826",
+    "816543792527689413493271568675918234238465971149732685352896147984127356761354829",
+    "285319476934627581167584923491238765672451398853796214326175849749863152518942637",
+    "746812935351649782892375146628953471917264358534187629479521863185436297263798514",
+    "251473986398625174476918532967384215813259647524167398132846759749532861685791423",
+    "189624375436759182527381649762835914945167238318492756271948563694573821853216497",
+    "359178624247596318816324795621485973985637241473219856532761489794853162168942537",
+    "137892456249563178568417239895631724416725983372948615981376542754289361623154897",
+    "687591432941237658235684719359178246472965183168423975723819564894756321516342897",
+    "153768942876294513249135867428351796531976284967842135614529378382417659795683421",
+    "625318794841927356973564812386142975154879263297653481418296537532781649769435128",
+    "134926578925748316768153249396481752472635891851297634243879165687514923519362487",
+    "864329751175486932329157468237945816598612374641738529713864295982571643456293187",
+    "526783941137496825894215367712634589389521476645978213453867192268159734971342658",
+    "539871426481629735762543918253798164694135287817462359176384592328957641945216873",
+    "153869274279435816846271395984127653365984127712653489431598762528746931697312548",
+    "673459812951782643842613597239576184587241369416398725194837256765124938328965471",
+    "621453879793826541548917623954278316186394257372561984867135492439782165215649738",
+    "517896342429513678368274951196358427753942186284761539842139765935687214671425893",
+    "295618734743529618861743592457291863639487251128356947974835126582164379316972485",
+    "594216783386457912712389456231748569975621834468935271147562398653894127829173645",
+    "859147326274693851361582974147268593682359417935714268796435182513826749428971635",
+    "152798634936541782478632951649357218713286549825914367361479825287165493594823176",
+    "913652748842917635756483219378249561125368974694571382237894156461725893589136427",
+    "536284179942571638718936452254193867189647523367825941693758214871462395425319786",
+    "154796823372485691698231574745823169836179245219654387581967432923548716467312958",
+    "329671548751894632846352197592437861418569723637128459975286314183945276264713985"
+};
+
+const int kTriplePermutations[6][3] = {
+    {0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}
+};
+
+template <typename Engine>
+void ShuffleLines(std::array<int, Solver::BOARD_SIZE>& lines, Engine& rng) {
+    const int* groups = kTriplePermutations[RandomBelow(rng, 6)];
+    for (int group = 0; group < Solver::BOX_SIZE; ++group) {
+        const int* within = kTriplePermutations[RandomBelow(rng, 6)];
+        for (int i = 0; i < Solver::BOX_SIZE; ++i) {
+            lines[group * Solver::BOX_SIZE + i] = groups[group] * Solver::BOX_SIZE + within[i];
+        }
+    }
+}
+
+template <typename Engine>
+void GenerateGrid(Solver::Grid& grid, Engine& rng) {
+    const char* base = kBaseGrids[RandomBelow(rng, GridGenerator::BASE_GRID_COUNT)];
+
+    std::array<int, Solver::BOARD_SIZE + 1> digits;
+    for (int i = 0; i <= Solver::BOARD_SIZE; ++i) {
+        digits[i] = i;
+    }
+    Shuffle(digits.begin() + 1, digits.end(), rng);
+
+    std::array<int, Solver::BOARD_SIZE> rows;
+    std::array<int, Solver::BOARD_SIZE> cols;
+    ShuffleLines(rows, rng);
+    ShuffleLines(cols, rng);
+
+    int rowStride = Solver::BOARD_SIZE;
+    int colStride = 1;
+    if (RandomBelow(rng, 2) == 1) {
+        std::swap(rowStride, colStride);
+    }
+
+    for (int row = 0; row < Solver::BOARD_SIZE; ++row) {
+        const char* source = base + rows[row] * rowStride;
+        for (int col = 0; col < Solver::BOARD_SIZE; ++col) {
+            grid[row][col] = digits[source[cols[col] * colStride] - '0'];
+        }
+    }
+}
+
+}
+
+void GridGenerator::Generate(Solver::Grid& grid, RandomEngine& rng) {
+    GenerateGrid(grid, rng);
+}
+
+void GridGenerator::Generate(Solver::Grid& grid, LegacyRandomEngine& rng) {
+    GenerateGrid(grid, rng);
+}
@@ -0,0 +1,97 @@
+#include "PackedBoard.h"
+#include "BitUtils.h"
+#include <cstring>
+
+PackedBoard PackedBoard::FromGrid(const Solver::Grid& grid) {
+    PackedBoard board;
+    board.Assign(grid);
+    return board;
+}
+
+PackedBoard PackedBoard::FromGivens(const Solver::Grid& givens) {
+    PackedBoard board;
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        int value = givens[cell / BOARD_SIZE][cell % BOARD_SIZE];
+        if (value != Solver::EMPTY_CELL) {
+            board.Set(cell, value);
+            board.SetGiven(cell, true);
+        }
+    }
+    return board;
+}
+
+void PackedBoard::Assign(const Solver::Grid& grid) {
+    for (int cell = 0; cell < CELL_COUNT; cell += 2) {
+        int low = grid[cell / BOARD_SIZE][cell % BOARD_SIZE];
+        int high = cell + 1 < CELL_COUNT ? grid[(cell + 1) / BOARD_SIZE][(cell + 1) % BOARD_SIZE] : 0;
+        mCells[cell >> 1] = static_cast<uint8_t>(low | (high << 4));
+    }
+}
+
+void PackedBoard::ToGrid(Solver::Grid& grid) const {
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        grid[cell / BOARD_SIZE][cell % BOARD_SIZE] = Get(cell);
+    }
+}
+
+PackedBoard PackedBoard::GetGivens() const {
+    PackedBoard givens;
+    givens.mGivens = mGivens;
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        if (IsGiven(cell)) {
+            givens.Set(cell, Get(cell));
+        }
+    }
+    return givens;
+}
+
+int PackedBoard::CountGivens() const {
+    return CountBits(static_cast<uint32_t>(mGivens[0])) + CountBits(static_cast<uint32_t>(mGivens[0] >> 32)) +
+        CountBits(static_cast<uint32_t>(mGivens[1]));
+}
+
+bool PackedBoard::Parse(const char* text, size_t length) {
+    if (length != static_cast<size_t>(TEXT_LENGTH)) {
+        return false;
+    }
+
+    PackedBoard board;
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        char c = text[cell];
+        if (c >= '1' && c <= '9') {
+            board.Set(cell, c - '0');
+            board.SetGiven(cell, true);
+        } else if (c != '0' && c != '.') {
+            return false;
+        }
+    }
+    *this = board;
+    return true;
+}
+
+void PackedBoard::Format(char* text) const {
+    for (int cell = 0; cell < CELL_COUNT; ++cell) {
+        int value = Get(cell);
+        text[cell] = value == Solver::EMPTY_CELL ? '.' : static_cast<char>('0' + value);
+    }
+}
+
+uint64_t PackedBoard::Hash() const {
+    uint64_t words[8];
+    std::memcpy(words, this, sizeof(words));
+
+    uint64_t hash = 0x9E3779B97F4A7C15ull;
+    for (uint64_t word : words) {
+        hash = (hash ^ word) * 0xBF58476D1CE4E5B9ull;
+        hash ^= hash >> 31;
+    }
+    return hash;
+}
+
+bool PackedBoard::operator==(const PackedBoard& other) const {
+    return std::memcmp(this, &other, sizeof(PackedBoard)) == 0;
+}
+
+bool PackedBoard::operator!=(const PackedBoard& other) const {
+    return !(*this == other);
+}
@@ -0,0 +1,80 @@
+#include "PuzzlePool.h"
+#include <chrono>
+
+PuzzlePool::PuzzlePool()
+    : mRunning(false)
+{
+}
+
+PuzzlePool::~PuzzlePool() {
+    Stop();
+}
+
+void PuzzlePool::Start() {
+    if (mRunning.exchange(true)) {
+        return;
+    }
+    mWorker = std::thread(&PuzzlePool::WorkerLoop, this);
+}
+
+void PuzzlePool::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mWakeMutex);
+        mRunning = false;
+    }
+    mWake.notify_one();
+
+    if (mWorker.joinable()) {
+        mWorker.join();
+    }
+}
+
+bool PuzzlePool::TryTake(int difficulty, GeneratedPuzzle& puzzle) {
+    if (difficulty < 1 || difficulty > DIFFICULTY_COUNT) {
+        return false;
+    }
+
+    if (!mQueues[difficulty - 1].TryPop(puzzle)) {
+        return false;
+    }
+    mWake.notify_one();
+    return true;
+}
+
+size_t PuzzlePool::GetReadyCount(int difficulty) const {
+    if (difficulty < 1 || difficulty > DIFFICULTY_COUNT) {
+        return 0;
+    }
+    return mQueues[difficulty - 1].Size();
+}
+
+void PuzzlePool::WorkerLoop() {
+    SudokuBoard generator;
+
+    while (mRunning) {
+        int difficulty = PickDifficultyToRefill();
+        if (difficulty < 0) {
+            std::unique_lock<std::mutex> lock(mWakeMutex);
+            mWake.wait_for(lock, std::chrono::milliseconds(250), [this]() {
+                return !mRunning || PickDifficultyToRefill() >= 0;
+            });
+            continue;
+        }
+
+        generator.NewGame(difficulty);
+        mQueues[difficulty - 1].TryPush(generator.ExportPuzzle());
+    }
+}
+
+int PuzzlePool::PickDifficultyToRefill() const {
+    int best = -1;
+    size_t bestCount = PUZZLES_PER_DIFFICULTY;
+    for (int i = 0; i < DIFFICULTY_COUNT; ++i) {
+        size_t count = mQueues[i].Size();
+        if (count < bestCount) {
+            best = i + 1;
+            bestCount = count;
+        }
+    }
+    return best;
+}
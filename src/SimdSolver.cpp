@@ -0,0 +1,543 @@
+#include "SimdSolver.h"
+#include "BitUtils.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SUDOKU_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(SUDOKU_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SUDOKU_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SUDOKU_TARGET(isa)
+#endif
+
+using Lanes = SimdSolver::Lanes;
+
+struct ApplyContext {
+    Lanes placedCol;
+    Lanes hiddenCol;
+    std::array<Lanes, SimdSolver::BOX_SIZE> placedBand;
+    std::array<Lanes, SimdSolver::BOX_SIZE> hiddenBand;
+    std::array<uint16_t, SimdSolver::BOARD_SIZE> placedRow;
+    std::array<uint16_t, SimdSolver::BOARD_SIZE> hiddenRow;
+};
+
+struct SimdKernels {
+    void (*extractSingles)(const Lanes* cells, Lanes* singles);
+    void (*reduceUnits)(const Lanes* units, Lanes& once, Lanes& twice);
+    int (*applyRows)(Lanes* rows, const ApplyContext& context);
+};
+
+namespace {
+
+const int UNIT_COUNT = SimdSolver::BOARD_SIZE;
+const int LANE_COUNT = SimdSolver::LANE_COUNT;
+const int APPLY_CHANGED = 1;
+const int APPLY_EMPTY_CELL = 2;
+
+alignas(32) const uint16_t kUnitLaneMask[LANE_COUNT] = {
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0, 0, 0, 0, 0, 0, 0
+};
+
+void ExtractSinglesScalar(const Lanes* cells, Lanes* singles) {
+    for (int u = 0; u < UNIT_COUNT; ++u) {
+        for (int l = 0; l < LANE_COUNT; ++l) {
+            uint16_t x = cells[u].v[l];
+            singles[u].v[l] = (x & (x - 1)) == 0 ? x : 0;
+        }
+    }
+}
+
+void ReduceUnitsScalar(const Lanes* units, Lanes& once, Lanes& twice) {
+    for (int l = 0; l < LANE_COUNT; ++l) {
+        uint16_t seenOnce = 0;
+        uint16_t seenTwice = 0;
+        for (int u = 0; u < UNIT_COUNT; ++u) {
+            seenTwice |= seenOnce & units[u].v[l];
+            seenOnce |= units[u].v[l];
+        }
+        once.v[l] = seenOnce;
+        twice.v[l] = seenTwice;
+    }
+}
+
+int ApplyRowsScalar(Lanes* rows, const ApplyContext& context) {
+    int flags = 0;
+    for (int r = 0; r < UNIT_COUNT; ++r) {
+        int band = r / SimdSolver::BOX_SIZE;
+        for (int l = 0; l < UNIT_COUNT; ++l) {
+            uint16_t x = rows[r].v[l];
+            uint16_t eliminated = context.placedRow[r] | context.placedCol.v[l] | context.placedBand[band].v[l];
+            uint16_t cell = (x & (x - 1)) == 0 ? x : static_cast<uint16_t>(x & ~eliminated);
+            uint16_t hidden = cell & (context.hiddenRow[r] | context.hiddenCol.v[l] | context.hiddenBand[band].v[l]);
+            if (hidden != 0) {
+                cell = hidden;
+            }
+
+            if (cell != x) {
+                flags |= APPLY_CHANGED;
+            }
+            if (cell == 0) {
+                flags |= APPLY_EMPTY_CELL;
+            }
+            rows[r].v[l] = cell;
+        }
+    }
+    return flags;
+}
+
+const SimdKernels kScalarKernels = {
+    ExtractSinglesScalar,
+    ReduceUnitsScalar,
+    ApplyRowsScalar
+};
+
+#if defined(SUDOKU_SIMD_X86)
+
+SUDOKU_TARGET("sse4.1")
+void ExtractSinglesSse41(const Lanes* cells, Lanes* singles) {
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i zero = _mm_setzero_si128();
+    for (int u = 0; u < UNIT_COUNT; ++u) {
+        for (int h = 0; h < LANE_COUNT; h += 8) {
+            __m128i x = _mm_load_si128(reinterpret_cast<const __m128i*>(cells[u].v + h));
+            __m128i isSingle = _mm_cmpeq_epi16(_mm_and_si128(x, _mm_sub_epi16(x, one)), zero);
+            _mm_store_si128(reinterpret_cast<__m128i*>(singles[u].v + h), _mm_and_si128(x, isSingle));
+        }
+    }
+}
+
+SUDOKU_TARGET("sse4.1")
+void ReduceUnitsSse41(const Lanes* units, Lanes& once, Lanes& twice) {
+    for (int h = 0; h < LANE_COUNT; h += 8) {
+        __m128i seenOnce = _mm_setzero_si128();
+        __m128i seenTwice = _mm_setzero_si128();
+        for (int u = 0; u < UNIT_COUNT; ++u) {
+            __m128i x = _mm_load_si128(reinterpret_cast<const __m128i*>(units[u].v + h));
+            seenTwice = _mm_or_si128(seenTwice, _mm_and_si128(seenOnce, x));
+            seenOnce = _mm_or_si128(seenOnce, x);
+        }
+        _mm_store_si128(reinterpret_cast<__m128i*>(once.v + h), seenOnce);
+        _mm_store_si128(reinterpret_cast<__m128i*>(twice.v + h), seenTwice);
+    }
+}
+
+SUDOKU_TARGET("sse4.1")
+int ApplyRowsSse41(Lanes* rows, const ApplyContext& context) {
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i changed = zero;
+    __m128i empty = zero;
+
+    for (int r = 0; r < UNIT_COUNT; ++r) {
+        int band = r / SimdSolver::BOX_SIZE;
+        __m128i rowPlaced = _mm_set1_epi16(static_cast<short>(context.placedRow[r]));
+        __m128i rowHidden = _mm_set1_epi16(static_cast<short>(context.hiddenRow[r]));
+
+        for (int h = 0; h < LANE_COUNT; h += 8) {
+            __m128i laneMask = _mm_load_si128(reinterpret_cast<const __m128i*>(kUnitLaneMask + h));
+            __m128i x = _mm_load_si128(reinterpret_cast<const __m128i*>(rows[r].v + h));
+            __m128i isSingle = _mm_cmpeq_epi16(_mm_and_si128(x, _mm_sub_epi16(x, one)), zero);
+
+            __m128i eliminated = _mm_or_si128(
+                _mm_and_si128(rowPlaced, laneMask),
+                _mm_or_si128(
+                    _mm_load_si128(reinterpret_cast<const __m128i*>(context.placedCol.v + h)),
+                    _mm_load_si128(reinterpret_cast<const __m128i*>(context.placedBand[band].v + h))));
+            __m128i cell = _mm_andnot_si128(_mm_andnot_si128(isSingle, eliminated), x);
+
+            __m128i hiddenMask = _mm_or_si128(
+                _mm_and_si128(rowHidden, laneMask),
+                _mm_or_si128(
+                    _mm_load_si128(reinterpret_cast<const __m128i*>(context.hiddenCol.v + h)),
+                    _mm_load_si128(reinterpret_cast<const __m128i*>(context.hiddenBand[band].v + h))));
+            __m128i hidden = _mm_and_si128(cell, hiddenMask);
+            cell = _mm_blendv_epi8(hidden, cell, _mm_cmpeq_epi16(hidden, zero));
+
+            changed = _mm_or_si128(changed, _mm_xor_si128(cell, x));
+            empty = _mm_or_si128(empty, _mm_cmpeq_epi16(cell, zero));
+            _mm_store_si128(reinterpret_cast<__m128i*>(rows[r].v + h), cell);
+        }
+    }
+
+    int flags = 0;
+    if (!_mm_testz_si128(changed, changed)) {
+        flags |= APPLY_CHANGED;
+    }
+    if (!_mm_testz_si128(empty, empty)) {
+        flags |= APPLY_EMPTY_CELL;
+    }
+    return flags;
+}
+
+SUDOKU_TARGET("avx2")
+void ExtractSinglesAvx2(const Lanes* cells, Lanes* singles) {
+    const __m256i one = _mm256_set1_epi16(1);
+    const __m256i zero = _mm256_setzero_si256();
+    for (int u = 0; u < UNIT_COUNT; ++u) {
+        __m256i x = _mm256_load_si256(reinterpret_cast<const __m256i*>(cells[u].v));
+        __m256i isSingle = _mm256_cmpeq_epi16(_mm256_and_si256(x, _mm256_sub_epi16(x, one)), zero);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(singles[u].v), _mm256_and_si256(x, isSingle));
+    }
+}
+
+SUDOKU_TARGET("avx2")
+void ReduceUnitsAvx2(const Lanes* units, Lanes& once, Lanes& twice) {
+    __m256i seenOnce = _mm256_setzero_si256();
+    __m256i seenTwice = _mm256_setzero_si256();
+    for (int u = 0; u < UNIT_COUNT; ++u) {
+        __m256i x = _mm256_load_si256(reinterpret_cast<const __m256i*>(units[u].v));
+        seenTwice = _mm256_or_si256(seenTwice, _mm256_and_si256(seenOnce, x));
+        seenOnce = _mm256_or_si256(seenOnce, x);
+    }
+    _mm256_store_si256(reinterpret_cast<__m256i*>(once.v), seenOnce);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(twice.v), seenTwice);
+}
+
+SUDOKU_TARGET("avx2")
+int ApplyRowsAvx2(Lanes* rows, const ApplyContext& context) {
+    const __m256i one = _mm256_set1_epi16(1);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i laneMask = _mm256_load_si256(reinterpret_cast<const __m256i*>(kUnitLaneMask));
+    const __m256i placedCol = _mm256_load_si256(reinterpret_cast<const __m256i*>(context.placedCol.v));
+    const __m256i hiddenCol = _mm256_load_si256(reinterpret_cast<const __m256i*>(context.hiddenCol.v));
+    __m256i changed = zero;
+    __m256i empty = zero;
+
+    for (int r = 0; r < UNIT_COUNT; ++r) {
+        int band = r / SimdSolver::BOX_SIZE;
+        __m256i x = _mm256_load_si256(reinterpret_cast<const __m256i*>(rows[r].v));
+        __m256i isSingle = _mm256_cmpeq_epi16(_mm256_and_si256(x, _mm256_sub_epi16(x, one)), zero);
+
+        __m256i eliminated = _mm256_or_si256(
+            _mm256_and_si256(_mm256_set1_epi16(static_cast<short>(context.placedRow[r])), laneMask),
+            _mm256_or_si256(
+                placedCol,
+                _mm256_load_si256(reinterpret_cast<const __m256i*>(context.placedBand[band].v))));
+        __m256i cell = _mm256_andnot_si256(_mm256_andnot_si256(isSingle, eliminated), x);
+
+        __m256i hiddenMask = _mm256_or_si256(
+            _mm256_and_si256(_mm256_set1_epi16(static_cast<short>(context.hiddenRow[r])), laneMask),
+            _mm256_or_si256(
+                hiddenCol,
+                _mm256_load_si256(reinterpret_cast<const __m256i*>(context.hiddenBand[band].v))));
+        __m256i hidden = _mm256_and_si256(cell, hiddenMask);
+        cell = _mm256_blendv_epi8(hidden, cell, _mm256_cmpeq_epi16(hidden, zero));
+
+        changed = _mm256_or_si256(changed, _mm256_xor_si256(cell, x));
+        empty = _mm256_or_si256(empty, _mm256_cmpeq_epi16(cell, zero));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(rows[r].v), cell);
+    }
+
+    int flags = 0;
+    if (!_mm256_testz_si256(changed, changed)) {
+        flags |= APPLY_CHANGED;
+    }
+    if (!_mm256_testz_si256(empty, empty)) {
+        flags |= APPLY_EMPTY_CELL;
+    }
+    return flags;
+}
+
+const SimdKernels kSse41Kernels = {
+    ExtractSinglesSse41,
+    ReduceUnitsSse41,
+    ApplyRowsSse41
+};
+
+const SimdKernels kAvx2Kernels = {
+    ExtractSinglesAvx2,
+    ReduceUnitsAvx2,
+    ApplyRowsAvx2
+};
+
+#endif
+
+const SimdKernels* KernelsFor(SimdLevel level) {
+#if defined(SUDOKU_SIMD_X86)
+    switch (level) {
+        case SimdLevel::AVX2:
+            return &kAvx2Kernels;
+        case SimdLevel::SSE41:
+            return &kSse41Kernels;
+        default:
+            break;
+    }
+#endif
+    return &kScalarKernels;
+}
+
+struct GatherTables {
+    std::array<uint8_t, UNIT_COUNT * UNIT_COUNT> byRow;
+    std::array<uint8_t, UNIT_COUNT * UNIT_COUNT> byBox;
+};
+
+const GatherTables& GetGatherTables() {
+    static const GatherTables tables = [] {
+        GatherTables t;
+        for (int i = 0; i < UNIT_COUNT; ++i) {
+            for (int j = 0; j < UNIT_COUNT; ++j) {
+                t.byRow[i * UNIT_COUNT + j] = static_cast<uint8_t>(j * LANE_COUNT + i);
+
+                int row = (j / SimdSolver::BOX_SIZE) * SimdSolver::BOX_SIZE + i / SimdSolver::BOX_SIZE;
+                int col = (j % SimdSolver::BOX_SIZE) * SimdSolver::BOX_SIZE + i % SimdSolver::BOX_SIZE;
+                t.byBox[i * UNIT_COUNT + j] = static_cast<uint8_t>(row * LANE_COUNT + col);
+            }
+        }
+        return t;
+    }();
+    return tables;
+}
+
+void Gather(const SimdSolver::State& state, const std::array<uint8_t, UNIT_COUNT * UNIT_COUNT>& table, Lanes* units) {
+    const uint16_t* cells = state.rows[0].v;
+    for (int i = 0; i < UNIT_COUNT; ++i) {
+        for (int j = 0; j < UNIT_COUNT; ++j) {
+            units[i].v[j] = cells[table[i * UNIT_COUNT + j]];
+        }
+    }
+}
+
+}
+
+SimdSolver::SimdSolver()
+    : mLevel(SimdLevel::SCALAR)
+    , mKernels(&kScalarKernels)
+{
+    SetSimdLevel(DetectSimdLevel());
+}
+
+bool SimdSolver::Solve(Grid& board) {
+    mStats.solves++;
+    if (!LoadState(board, mStack[0])) {
+        return false;
+    }
+    return Search(1, &board) > 0;
+}
+
+int SimdSolver::CountSolutions(const Grid& board, int limit) {
+    mStats.solves++;
+    if (!LoadState(board, mStack[0])) {
+        return 0;
+    }
+    return Search(limit, nullptr);
+}
+
+SolverEngine SimdSolver::GetEngine() const {
+    return SolverEngine::SIMD_PROPAGATION;
+}
+
+std::unique_ptr<Solver> SimdSolver::Clone() const {
+    return std::make_unique<SimdSolver>(*this);
+}
+
+SimdLevel SimdSolver::GetSimdLevel() const {
+    return mLevel;
+}
+
+void SimdSolver::SetSimdLevel(SimdLevel level) {
+    SimdLevel supported = DetectSimdLevel();
+    if (static_cast<int>(level) > static_cast<int>(supported)) {
+        level = supported;
+    }
+    mLevel = level;
+    mKernels = KernelsFor(level);
+}
+
+SimdLevel SimdSolver::DetectSimdLevel() {
+#if defined(SUDOKU_SIMD_X86)
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    bool sse41 = (info[2] & (1 << 19)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+
+    bool avx2 = false;
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    bool sse41 = __builtin_cpu_supports("sse4.1");
+    bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+    if (avx2) {
+        return SimdLevel::AVX2;
+    }
+    if (sse41) {
+        return SimdLevel::SSE41;
+    }
+#endif
+    return SimdLevel::SCALAR;
+}
+
+int SimdSolver::Search(int limit, Grid* board) {
+    int count = 0;
+    int depth = 0;
+
+    for (;;) {
+        mStats.nodes++;
+        State& state = mStack[depth];
+
+        if (Propagate(state)) {
+            int row = -1;
+            int col = -1;
+            if (SelectBranchCell(state, row, col)) {
+                uint16_t& cell = state.rows[row].v[col];
+                uint16_t bit = PickCandidate(cell);
+                cell = static_cast<uint16_t>(cell & ~bit);
+
+                mStack[depth + 1] = state;
+                mStack[depth + 1].rows[row].v[col] = bit;
+                depth++;
+                continue;
+            }
+
+            count++;
+            if (board) {
+                WriteSolution(state, *board);
+            }
+            if (limit > 0 && count >= limit) {
+                return count;
+            }
+        } else {
+            mStats.backtracks++;
+        }
+
+        if (depth == 0) {
+            return count;
+        }
+        depth--;
+    }
+}
+
+bool SimdSolver::LoadState(const Grid& board, State& state) const {
+    for (int row = 0; row < BOARD_SIZE; ++row) {
+        for (int l = 0; l < LANE_COUNT; ++l) {
+            state.rows[row].v[l] = ALL_CANDIDATES;
+        }
+
+        for (int col = 0; col < BOARD_SIZE; ++col) {
+            int value = board[row][col];
+            if (value < EMPTY_CELL || value > BOARD_SIZE) {
+                return false;
+            }
+            if (value != EMPTY_CELL) {
+                state.rows[row].v[col] = static_cast<uint16_t>(1u << (value - 1));
+            }
+        }
+    }
+    return true;
+}
+
+bool SimdSolver::Propagate(State& state) const {
+    const GatherTables& tables = GetGatherTables();
+
+    alignas(32) Lanes singles[UNIT_COUNT];
+    alignas(32) Lanes byRow[UNIT_COUNT];
+    alignas(32) Lanes byBox[UNIT_COUNT];
+    for (int u = 0; u < UNIT_COUNT; ++u) {
+        for (int l = UNIT_COUNT; l < LANE_COUNT; ++l) {
+            byRow[u].v[l] = ALL_CANDIDATES;
+            byBox[u].v[l] = ALL_CANDIDATES;
+        }
+    }
+
+    for (;;) {
+        Lanes colOnce, colTwice, colPlaced, colDuplicates;
+        Lanes rowOnce, rowTwice, rowPlaced, rowDuplicates;
+        Lanes boxOnce, boxTwice, boxPlaced, boxDuplicates;
+
+        mKernels->extractSingles(state.rows.data(), singles);
+        mKernels->reduceUnits(singles, colPlaced, colDuplicates);
+        mKernels->reduceUnits(state.rows.data(), colOnce, colTwice);
+
+        Gather(state, tables.byRow, byRow);
+        mKernels->extractSingles(byRow, singles);
+        mKernels->reduceUnits(singles, rowPlaced, rowDuplicates);
+        mKernels->reduceUnits(byRow, rowOnce, rowTwice);
+
+        Gather(state, tables.byBox, byBox);
+        mKernels->extractSingles(byBox, singles);
+        mKernels->reduceUnits(singles, boxPlaced, boxDuplicates);
+        mKernels->reduceUnits(byBox, boxOnce, boxTwice);
+
+        ApplyContext context = {};
+        for (int u = 0; u < UNIT_COUNT; ++u) {
+            if ((colDuplicates.v[u] | rowDuplicates.v[u] | boxDuplicates.v[u]) != 0) {
+                return false;
+            }
+            if ((colOnce.v[u] & rowOnce.v[u] & boxOnce.v[u]) != ALL_CANDIDATES) {
+                return false;
+            }
+
+            context.placedCol.v[u] = colPlaced.v[u];
+            context.hiddenCol.v[u] = static_cast<uint16_t>(colOnce.v[u] & ~colTwice.v[u]);
+            context.placedRow[u] = rowPlaced.v[u];
+            context.hiddenRow[u] = static_cast<uint16_t>(rowOnce.v[u] & ~rowTwice.v[u]);
+
+            int band = u / BOX_SIZE;
+            int stack = u % BOX_SIZE;
+            for (int k = 0; k < BOX_SIZE; ++k) {
+                context.placedBand[band].v[stack * BOX_SIZE + k] = boxPlaced.v[u];
+                context.hiddenBand[band].v[stack * BOX_SIZE + k] = static_cast<uint16_t>(boxOnce.v[u] & ~boxTwice.v[u]);
+            }
+        }
+
+        int flags = mKernels->applyRows(state.rows.data(), context);
+        if (flags & APPLY_EMPTY_CELL) {
+            return false;
+        }
+        if ((flags & APPLY_CHANGED) == 0) {
+            return true;
+        }
+    }
+}
+
+bool SimdSolver::SelectBranchCell(const State& state, int& row, int& col) const {
+    int bestCount = BOARD_SIZE + 1;
+    for (int r = 0; r < BOARD_SIZE; ++r) {
+        for (int c = 0; c < BOARD_SIZE; ++c) {
+            int count = CountBits(state.rows[r].v[c]);
+            if (count > 1 && count < bestCount) {
+                row = r;
+                col = c;
+                bestCount = count;
+                if (count == 2) {
+                    return true;
+                }
+            }
+        }
+    }
+    return bestCount <= BOARD_SIZE;
+}
+
+uint16_t SimdSolver::PickCandidate(uint16_t candidates) {
+    if (!HasRandomSource()) {
+        return static_cast<uint16_t>(candidates & (~candidates + 1));
+    }
+
+    int skip = static_cast<int>(DrawBelow(static_cast<uint32_t>(CountBits(candidates))));
+    for (int i = 0; i < skip; ++i) {
+        candidates = static_cast<uint16_t>(candidates & (candidates - 1));
+    }
+    return static_cast<uint16_t>(candidates & (~candidates + 1));
+}
+
+void SimdSolver::WriteSolution(const State& state, Grid& board) const {
+    for (int row = 0; row < BOARD_SIZE; ++row) {
+        for (int col = 0; col < BOARD_SIZE; ++col) {
+            board[row][col] = LowestBitIndex(state.rows[row].v[col]) + 1;
+        }
+    }
+}
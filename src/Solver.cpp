@@ -0,0 +1,47 @@
+#include "Solver.h"
+#include "BacktrackingSolver.h"
+#include "DancingLinksSolver.h"
+#include "SimdSolver.h"
+
+Solver::Solver()
+    : mRng(nullptr)
+    , mLegacyRng(nullptr)
+{
+}
+
+void Solver::SetBranchingPolicy(BranchingPolicy) {
+}
+
+void Solver::SetRandomSource(RandomEngine* rng) {
+    mRng = rng;
+    mLegacyRng = nullptr;
+}
+
+void Solver::SetRandomSource(LegacyRandomEngine* rng) {
+    mRng = nullptr;
+    mLegacyRng = rng;
+}
+
+const SolverStats& Solver::GetStats() const {
+    return mStats;
+}
+
+void Solver::ResetStats() {
+    mStats = SolverStats();
+}
+
+int Solver::BoxIndex(int row, int col) {
+    return (row / BOX_SIZE) * BOX_SIZE + col / BOX_SIZE;
+}
+
+std::unique_ptr<Solver> CreateSolver(SolverEngine engine) {
+    switch (engine) {
+        case SolverEngine::DANCING_LINKS:
+            return std::make_unique<DancingLinksSolver>();
+        case SolverEngine::SIMD_PROPAGATION:
+            return std::make_unique<SimdSolver>();
+        case SolverEngine::BACKTRACKING:
+        default:
+            return std::make_unique<BacktrackingSolver>();
+    }
+}
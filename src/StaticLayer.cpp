@@ -0,0 +1,96 @@
+#include "StaticLayer.h"
+
+namespace {
+
+SDL_BlendMode PremultipliedBlendMode() {
+    return SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+}
+
+}
+
+StaticLayer::StaticLayer()
+    : mTexture(nullptr)
+    , mArea({0, 0, 0, 0})
+    , mWidth(0)
+    , mHeight(0)
+    , mValid(false)
+{
+}
+
+StaticLayer::~StaticLayer() {
+    Destroy();
+}
+
+bool StaticLayer::IsSupported(SDL_Renderer* renderer) {
+    return renderer && SDL_RenderTargetSupported(renderer) == SDL_TRUE;
+}
+
+bool StaticLayer::Begin(SDL_Renderer* renderer, const SDL_Rect& area) {
+    int width, height;
+    if (SDL_GetRendererOutputSize(renderer, &width, &height) != 0) {
+        return false;
+    }
+
+    if (mTexture && (mWidth != width || mHeight != height)) {
+        Destroy();
+    }
+
+    if (!mTexture) {
+        mTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+        if (!mTexture) {
+            return false;
+        }
+
+        if (SDL_SetTextureBlendMode(mTexture, PremultipliedBlendMode()) != 0) {
+            Destroy();
+            return false;
+        }
+
+        mWidth = width;
+        mHeight = height;
+    }
+
+    if (SDL_SetRenderTarget(renderer, mTexture) != 0) {
+        return false;
+    }
+
+    mArea = area;
+    mValid = false;
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    return true;
+}
+
+void StaticLayer::End(SDL_Renderer* renderer) {
+    SDL_SetRenderTarget(renderer, nullptr);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    mValid = true;
+}
+
+void StaticLayer::Draw(SDL_Renderer* renderer) const {
+    if (mValid) {
+        SDL_RenderCopy(renderer, mTexture, &mArea, &mArea);
+    }
+}
+
+bool StaticLayer::IsValid() const {
+    return mValid;
+}
+
+void StaticLayer::Invalidate() {
+    mValid = false;
+}
+
+void StaticLayer::Destroy() {
+    if (mTexture) {
+        SDL_DestroyTexture(mTexture);
+        mTexture = nullptr;
+    }
+    mWidth = 0;
+    mHeight = 0;
+    mValid = false;
+}
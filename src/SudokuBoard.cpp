@@ -1,79 +1,264 @@
 #include "SudokuBoard.h"
+#include "GridGenerator.h"
+#include <cstdio>
+#include <cstdlib>
 #include <ctime>
 #include <iostream>
 #include <random>
 #include <algorithm>
 
-SudokuBoard::SudokuBoard() 
-    : mRng(std::random_device{}())
+SudokuBoard::SudokuBoard()
+    : SudokuBoard(std::random_device{}())
 {
-    for (int row = 0; row < BOARD_SIZE; ++row) {
-        for (int col = 0; col < BOARD_SIZE; ++col) {
-            mBoard[row][col] = EMPTY_CELL;
-            mOriginalCells[row][col] = false;
-        }
+}
+
+SudokuBoard::SudokuBoard(uint32_t seed)
+    : mHasSolution(false)
+    , mDifficulty(0)
+    , mPuzzleId(0)
+    , mRng(seed)
+    , mSolver(CreateSolver(SolverEngine::BACKTRACKING))
+    , mBranchingPolicy(BranchingPolicy::MIN_REMAINING_VALUES)
+    , mGeneratorMode(GeneratorMode::TRANSFORM)
+{
+    RecountCells();
+}
+
+SudokuBoard::SudokuBoard(const SudokuBoard& other)
+    : mCells(other.mCells)
+    , mSolution(other.mSolution)
+    , mHasSolution(other.mHasSolution)
+    , mDifficulty(other.mDifficulty)
+    , mPuzzleId(other.mPuzzleId)
+    , mRowCounts(other.mRowCounts)
+    , mColCounts(other.mColCounts)
+    , mBoxCounts(other.mBoxCounts)
+    , mFilledCount(other.mFilledCount)
+    , mConflictCount(other.mConflictCount)
+    , mConflicts(other.mConflicts)
+    , mSolvedCallback(other.mSolvedCallback)
+    , mRng(other.mRng)
+    , mSolver(other.mSolver->Clone())
+    , mBranchingPolicy(other.mBranchingPolicy)
+    , mGeneratorMode(other.mGeneratorMode)
+    , mDigger(other.mDigger)
+{
+    mSolver->SetRandomSource(&mRng);
+}
+
+SudokuBoard& SudokuBoard::operator=(const SudokuBoard& other) {
+    if (this != &other) {
+        *this = SudokuBoard(other);
     }
+    return *this;
+}
+
+void SudokuBoard::Seed(uint32_t seed) {
+    mRng.Seed(seed);
 }
 
 void SudokuBoard::NewGame(int difficulty) {
-    for (int row = 0; row < BOARD_SIZE; ++row) {
-        for (int col = 0; col < BOARD_SIZE; ++col) {
-            mBoard[row][col] = EMPTY_CELL;
-            mOriginalCells[row][col] = false;
+    NewGame(difficulty, static_cast<uint32_t>(mRng()));
+}
+
+void SudokuBoard::NewGame(int difficulty, uint32_t seed) {
+    mRng.Seed(seed);
+    Generate(difficulty, mRng);
+    mPuzzleId = MakePuzzleId(difficulty, seed);
+}
+
+template <typename Engine>
+void SudokuBoard::Generate(int difficulty, Engine& rng) {
+    Grid board;
+    GenerateCompleteSolution(board, rng);
+    mSolution = PackedBoard::FromGrid(board);
+    mHasSolution = true;
+    mDifficulty = difficulty;
+    
+    RemoveCells(board, difficulty, rng);
+    mCells = PackedBoard::FromGivens(board);
+    RecountCells();
+}
+
+bool SudokuBoard::NewGame(int difficulty, Technique target, int maxAttempts) {
+    GeneratedPuzzle best;
+    int bestDistance = -1;
+
+    for (int attempt = 0; attempt < maxAttempts; ++attempt) {
+        NewGame(difficulty);
+
+        PuzzleGrade grade;
+        if (!GradePuzzle(grade)) {
+            continue;
+        }
+        int distance = std::abs(static_cast<int>(grade.hardest) - static_cast<int>(target));
+        if (distance == 0) {
+            return true;
+        }
+        if (bestDistance < 0 || distance < bestDistance) {
+            bestDistance = distance;
+            best = ExportPuzzle();
         }
     }
-    
-    GenerateCompleteSolution();
-    
-    RemoveCells(difficulty);
+
+    if (bestDistance >= 0) {
+        LoadGeneratedPuzzle(best);
+    }
+    return false;
 }
 
-bool SudokuBoard::IsSolved() const {
-    for (int row = 0; row < BOARD_SIZE; ++row) {
-        for (int col = 0; col < BOARD_SIZE; ++col) {
-            if (mBoard[row][col] == EMPTY_CELL) {
-                return false;
-            }
-        }
+bool SudokuBoard::GradePuzzle(PuzzleGrade& grade) const {
+    return Grader::Grade(GetGivens(), grade);
+}
+
+uint64_t SudokuBoard::MakePuzzleId(int difficulty, uint32_t seed) const {
+    uint64_t generator = 0;
+    if (mGeneratorMode == GeneratorMode::TRANSFORM) {
+        generator = 1;
+    } else {
+        generator = (static_cast<uint64_t>(mSolver->GetEngine()) << 1) |
+            (static_cast<uint64_t>(mBranchingPolicy) << 3);
+    }
+    return (static_cast<uint64_t>(PUZZLE_ID_VERSION) << 56) |
+        (static_cast<uint64_t>(static_cast<uint8_t>(difficulty)) << 48) |
+        (generator << 40) | seed;
+}
+
+bool SudokuBoard::NewGameFromId(uint64_t id) {
+    uint32_t version = static_cast<uint32_t>(id >> 56);
+    int difficulty = static_cast<int>((id >> 48) & 0xFF);
+    uint32_t generator = static_cast<uint32_t>((id >> 40) & 0xFF);
+    uint32_t reserved = static_cast<uint32_t>((id >> 32) & 0xFF);
+    uint32_t engine = (generator >> 1) & 0x3;
+    uint32_t policy = (generator >> 3) & 0x1;
+
+    if ((version != PUZZLE_ID_VERSION && version != LEGACY_PUZZLE_ID_VERSION) || difficulty < 1 || difficulty > 3 || reserved != 0 ||
+        generator > 0xF || engine > static_cast<uint32_t>(SolverEngine::SIMD_PROPAGATION) ||
+        ((generator & 1) && generator != 1)) {
+        return false;
     }
-    
-    for (int i = 0; i < BOARD_SIZE; ++i) {
-        for (int num = 1; num <= BOARD_SIZE; ++num) {
-            if (!IsValidInRow(i, num)) {
-                return false;
-            }
+
+    GeneratorMode previousMode = mGeneratorMode;
+    SolverEngine previousEngine = mSolver->GetEngine();
+    BranchingPolicy previousPolicy = mBranchingPolicy;
+
+    if (generator & 1) {
+        SetGeneratorMode(GeneratorMode::TRANSFORM);
+    } else {
+        SetGeneratorMode(GeneratorMode::SOLVER);
+        SetSolverEngine(static_cast<SolverEngine>(engine));
+        SetBranchingPolicy(static_cast<BranchingPolicy>(policy));
+    }
+
+    if (version == PUZZLE_ID_VERSION) {
+        NewGame(difficulty, static_cast<uint32_t>(id));
+    } else {
+        LegacyRandomEngine rng(static_cast<uint32_t>(id));
+        Generate(difficulty, rng);
+        mSolver->SetRandomSource(&mRng);
+        mRng.Seed(static_cast<uint32_t>(id));
+        mPuzzleId = id;
+    }
+
+    SetGeneratorMode(previousMode);
+    SetSolverEngine(previousEngine);
+    SetBranchingPolicy(previousPolicy);
+    return true;
+}
+
+uint64_t SudokuBoard::GetPuzzleId() const {
+    return mPuzzleId;
+}
+
+int SudokuBoard::GetDifficulty() const {
+    return mDifficulty;
+}
+
+std::string SudokuBoard::FormatPuzzleId(uint64_t id) {
+    char text[17];
+    std::snprintf(text, sizeof(text), "%016llX", static_cast<unsigned long long>(id));
+    return text;
+}
+
+bool SudokuBoard::ParsePuzzleId(const char* text, uint64_t& id) {
+    uint64_t value = 0;
+    int digits = 0;
+    for (const char* c = text; *c; ++c, ++digits) {
+        int nibble;
+        if (*c >= '0' && *c <= '9') {
+            nibble = *c - '0';
+        } else if (*c >= 'A' && *c <= 'F') {
+            nibble = *c - 'A' + 10;
+        } else if (*c >= 'a' && *c <= 'f') {
+            nibble = *c - 'a' + 10;
+        } else {
+            return false;
         }
-        
-        for (int num = 1; num <= BOARD_SIZE; ++num) {
-            if (!IsValidInColumn(i, num)) {
+        if (digits == 16) {
+            return false;
+        }
+        value = (value << 4) | static_cast<uint64_t>(nibble);
+    }
+    if (digits == 0) {
+        return false;
+    }
+    id = value;
+    return true;
+}
+
+void SudokuBoard::LoadGeneratedPuzzle(const GeneratedPuzzle& puzzle) {
+    mCells = puzzle.givens;
+    mSolution = puzzle.solution;
+    mHasSolution = true;
+    mDifficulty = puzzle.difficulty;
+    mPuzzleId = puzzle.id;
+    RecountCells();
+}
+
+GeneratedPuzzle SudokuBoard::ExportPuzzle() const {
+    GeneratedPuzzle puzzle;
+    puzzle.givens = mCells.GetGivens();
+    puzzle.solution = mSolution;
+    puzzle.difficulty = mDifficulty;
+    puzzle.id = mPuzzleId;
+    return puzzle;
+}
+
+bool SudokuBoard::LoadPuzzle(const Grid& givens) {
+    for (int row = 0; row < BOARD_SIZE; ++row) {
+        for (int col = 0; col < BOARD_SIZE; ++col) {
+            if (givens[row][col] < EMPTY_CELL || givens[row][col] > BOARD_SIZE) {
                 return false;
             }
         }
     }
     
-    for (int boxRow = 0; boxRow < BOX_SIZE; ++boxRow) {
-        for (int boxCol = 0; boxCol < BOX_SIZE; ++boxCol) {
-            for (int num = 1; num <= BOARD_SIZE; ++num) {
-                if (!IsValidInBox(boxRow, boxCol, num)) {
-                    return false;
-                }
-            }
-        }
+    if (!mDigger.Load(givens)) {
+        return false;
     }
     
+    mCells = PackedBoard::FromGivens(givens);
+    mHasSolution = false;
+    mDifficulty = 0;
+    mPuzzleId = 0;
+    RecountCells();
     return true;
 }
 
+bool SudokuBoard::IsSolved() const {
+    return mFilledCount == BOARD_SIZE * BOARD_SIZE && mConflictCount == 0;
+}
+
 int SudokuBoard::GetCell(int row, int col) const {
     if (row >= 0 && row < BOARD_SIZE && col >= 0 && col < BOARD_SIZE) {
-        return mBoard[row][col];
+        return mCells.Get(row, col);
     }
     return EMPTY_CELL;
 }
 
 bool SudokuBoard::IsOriginalCell(int row, int col) const {
     if (row >= 0 && row < BOARD_SIZE && col >= 0 && col < BOARD_SIZE) {
-        return mOriginalCells[row][col];
+        return mCells.IsGiven(row, col);
     }
     return false;
 }
@@ -84,91 +269,155 @@ bool SudokuBoard::IsValidMove(int row, int col, int value) const {
         return false;
     }
     
-    if (mOriginalCells[row][col]) {
+    if (mCells.IsGiven(row, col)) {
         return false;
     }
     
-    for (int c = 0; c < BOARD_SIZE; ++c) {
-        if (mBoard[row][c] == value) {
-            return false;
-        }
-    }
-    
-    for (int r = 0; r < BOARD_SIZE; ++r) {
-        if (mBoard[r][col] == value) {
-            return false;
-        }
-    }
-    
-    int boxRowStart = (row / BOX_SIZE) * BOX_SIZE;
-    int boxColStart = (col / BOX_SIZE) * BOX_SIZE;
-    
-    for (int r = boxRowStart; r < boxRowStart + BOX_SIZE; ++r) {
-        for (int c = boxColStart; c < boxColStart + BOX_SIZE; ++c) {
-            if (mBoard[r][c] == value) {
-                return false;
-            }
-        }
-    }
-    
-    return true;
+    return mRowCounts[row][value] == 0 && mColCounts[col][value] == 0 &&
+           mBoxCounts[Solver::BoxIndex(row, col)][value] == 0;
 }
 
 void SudokuBoard::SetCell(int row, int col, int value) {
     if (row >= 0 && row < BOARD_SIZE && col >= 0 && col < BOARD_SIZE &&
-        value >= 1 && value <= BOARD_SIZE && !mOriginalCells[row][col]) {
-        mBoard[row][col] = value;
+        value >= 1 && value <= BOARD_SIZE && !mCells.IsGiven(row, col)) {
+        bool wasSolved = IsSolved();
+        RemoveValue(row, col);
+        AddValue(row, col, value);
+        
+        if (!wasSolved && IsSolved() && mSolvedCallback) {
+            mSolvedCallback();
+        }
     }
 }
 
 void SudokuBoard::ClearCell(int row, int col) {
     if (row >= 0 && row < BOARD_SIZE && col >= 0 && col < BOARD_SIZE && 
-        !mOriginalCells[row][col]) {
-        mBoard[row][col] = EMPTY_CELL;
+        !mCells.IsGiven(row, col)) {
+        RemoveValue(row, col);
     }
 }
 
-bool SudokuBoard::GetHint(int& row, int& col, int& value) {
-    std::vector<std::pair<int, int>> emptyCells;
+void SudokuBoard::SetSolvedCallback(std::function<void()> callback) {
+    mSolvedCallback = std::move(callback);
+}
+
+void SudokuBoard::AddValue(int row, int col, int value) {
+    int box = Solver::BoxIndex(row, col);
+    mConflictCount += (mRowCounts[row][value] > 0) + (mColCounts[col][value] > 0) + (mBoxCounts[box][value] > 0);
+    mRowCounts[row][value]++;
+    mColCounts[col][value]++;
+    mBoxCounts[box][value]++;
+    mFilledCount++;
+    mCells.Set(row, col, value);
+    RefreshConflicts(row, col, value);
+}
+
+void SudokuBoard::RemoveValue(int row, int col) {
+    int value = mCells.Get(row, col);
+    if (value == EMPTY_CELL) {
+        return;
+    }
+    
+    int box = Solver::BoxIndex(row, col);
+    mRowCounts[row][value]--;
+    mColCounts[col][value]--;
+    mBoxCounts[box][value]--;
+    mConflictCount -= (mRowCounts[row][value] > 0) + (mColCounts[col][value] > 0) + (mBoxCounts[box][value] > 0);
+    mFilledCount--;
+    mCells.Set(row, col, EMPTY_CELL);
+    RefreshConflicts(row, col, value);
+}
+
+void SudokuBoard::RecountCells() {
+    PackedBoard board = mCells;
+    for (auto& counts : mRowCounts) {
+        counts.fill(0);
+    }
+    for (auto& counts : mColCounts) {
+        counts.fill(0);
+    }
+    for (auto& counts : mBoxCounts) {
+        counts.fill(0);
+    }
+    mFilledCount = 0;
+    mConflictCount = 0;
+    mConflicts.reset();
     
-    for (int r = 0; r < BOARD_SIZE; ++r) {
-        for (int c = 0; c < BOARD_SIZE; ++c) {
-            if (mBoard[r][c] == EMPTY_CELL) {
-                emptyCells.push_back({r, c});
+    for (int row = 0; row < BOARD_SIZE; ++row) {
+        for (int col = 0; col < BOARD_SIZE; ++col) {
+            mCells.Set(row, col, EMPTY_CELL);
+            if (board.Get(row, col) != EMPTY_CELL) {
+                AddValue(row, col, board.Get(row, col));
             }
         }
     }
-    
-    if (emptyCells.empty()) {
+}
+
+bool SudokuBoard::GetHint(int& row, int& col, int& value) {
+    int emptyCount = BOARD_SIZE * BOARD_SIZE - mFilledCount;
+    if (emptyCount == 0 || !EnsureSolution()) {
         return false;
     }
     
-    std::uniform_int_distribution<int> dist(0, static_cast<int>(emptyCells.size()) - 1);
-    int index = dist(mRng);
-    row = emptyCells[index].first;
-    col = emptyCells[index].second;
-    
-    auto boardCopy = mBoard;
-    
-    if (SolveBoard(boardCopy)) {
-        value = boardCopy[row][col];
+    int index = static_cast<int>(RandomBelow(mRng, static_cast<uint32_t>(emptyCount)));
+    for (int cell = 0; cell < BOARD_SIZE * BOARD_SIZE; ++cell) {
+        if (mCells.Get(cell) == EMPTY_CELL && index-- == 0) {
+            row = cell / BOARD_SIZE;
+            col = cell % BOARD_SIZE;
+            value = mSolution.Get(cell);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SudokuBoard::IsCorrectEntry(int row, int col, int value) {
+    if (row < 0 || row >= BOARD_SIZE || col < 0 || col >= BOARD_SIZE || !EnsureSolution()) {
+        return false;
+    }
+    return mSolution.Get(row, col) == value;
+}
+
+bool SudokuBoard::EnsureSolution() {
+    if (mHasSolution) {
         return true;
     }
     
-    return false;
+    Grid solution = GetGivens();
+    if (!SolveBoard(solution)) {
+        return false;
+    }
+    
+    mSolution = PackedBoard::FromGrid(solution);
+    mHasSolution = true;
+    return true;
+}
+
+SudokuBoard::Grid SudokuBoard::GetGivens() const {
+    Grid givens;
+    mCells.GetGivens().ToGrid(givens);
+    return givens;
 }
 
-void SudokuBoard::GenerateCompleteSolution() {
+template <typename Engine>
+void SudokuBoard::GenerateCompleteSolution(Grid& board, Engine& rng) {
+    if (mGeneratorMode == GeneratorMode::TRANSFORM) {
+        GridGenerator::Generate(board, rng);
+        return;
+    }
+
     for (int row = 0; row < BOARD_SIZE; ++row) {
         for (int col = 0; col < BOARD_SIZE; ++col) {
-            mBoard[row][col] = EMPTY_CELL;
+            board[row][col] = EMPTY_CELL;
         }
     }
     
-    SolveBoard(mBoard);
+    mSolver->SetRandomSource(&rng);
+    mSolver->Solve(board);
 }
 
-void SudokuBoard::RemoveCells(int difficulty) {
+template <typename Engine>
+void SudokuBoard::RemoveCells(Grid& board, int difficulty, Engine& rng) {
     int cellsToRemove;
     switch (difficulty) {
         case 1:
@@ -184,187 +433,125 @@ void SudokuBoard::RemoveCells(int difficulty) {
             cellsToRemove = 50;
     }
     
+    std::array<std::pair<int, int>, BOARD_SIZE * BOARD_SIZE> cells;
     for (int row = 0; row < BOARD_SIZE; ++row) {
         for (int col = 0; col < BOARD_SIZE; ++col) {
-            mOriginalCells[row][col] = true;
+            cells[row * BOARD_SIZE + col] = {row, col};
         }
     }
     
-    std::vector<std::pair<int, int>> cells;
-    for (int row = 0; row < BOARD_SIZE; ++row) {
-        for (int col = 0; col < BOARD_SIZE; ++col) {
-            cells.push_back({row, col});
-        }
-    }
+    Shuffle(cells.begin(), cells.end(), rng);
     
-    std::shuffle(cells.begin(), cells.end(), mRng);
+    mDigger.Load(board);
     
-    for (int i = 0; i < cellsToRemove && i < cells.size(); ++i) {
+    int removed = 0;
+    for (size_t i = 0; i < cells.size() && removed < cellsToRemove; ++i) {
         int row = cells[i].first;
         int col = cells[i].second;
         
-        int temp = mBoard[row][col];
-        mBoard[row][col] = EMPTY_CELL;
-        mOriginalCells[row][col] = false;
-        auto boardCopy = mBoard;
+        int temp = board[row][col];
+        board[row][col] = EMPTY_CELL;
+        mDigger.Unassign(row, col, temp);
         
-        if (!SolveBoard(boardCopy)) {
-            mBoard[row][col] = temp;
-            mOriginalCells[row][col] = true;
+        if (mDigger.HasOtherSolution(board, row, col, temp)) {
+            board[row][col] = temp;
+            mDigger.Assign(row, col, temp);
+        } else {
+            removed++;
         }
     }
 }
 
-bool SudokuBoard::SolveBoard(std::array<std::array<int, BOARD_SIZE>, BOARD_SIZE>& board) {
-    int row = -1;
-    int col = -1;
-    bool isEmpty = false;
-    
-    for (int r = 0; r < BOARD_SIZE; ++r) {
-        for (int c = 0; c < BOARD_SIZE; ++c) {
-            if (board[r][c] == EMPTY_CELL) {
-                row = r;
-                col = c;
-                isEmpty = true;
-                break;
-            }
-        }
-        if (isEmpty) {
-            break;
-        }
-    }
-    
-    if (!isEmpty) {
-        return true;
-    }
-    
-    std::vector<int> numbers(BOARD_SIZE);
-    for (int i = 0; i < BOARD_SIZE; ++i) {
-        numbers[i] = i + 1;
-    }
-    std::shuffle(numbers.begin(), numbers.end(), mRng);
-    
-    for (int num : numbers) {
-        bool isValid = true;
-        
-        for (int c = 0; c < BOARD_SIZE; ++c) {
-            if (board[row][c] == num) {
-                isValid = false;
-                break;
-            }
-        }
-        
-        if (!isValid) {
-            continue;
-        }
-        
-        for (int r = 0; r < BOARD_SIZE; ++r) {
-            if (board[r][col] == num) {
-                isValid = false;
-                break;
-            }
-        }
-        
-        if (!isValid) {
-            continue;
-        }
-        
-        int boxRowStart = (row / BOX_SIZE) * BOX_SIZE;
-        int boxColStart = (col / BOX_SIZE) * BOX_SIZE;
-        
-        for (int r = boxRowStart; r < boxRowStart + BOX_SIZE; ++r) {
-            for (int c = boxColStart; c < boxColStart + BOX_SIZE; ++c) {
-                if (board[r][c] == num) {
-                    isValid = false;
-                    break;
-                }
-            }
-            if (!isValid) {
-                break;
-            }
-        }
-        
-        if (!isValid) {
-            continue;
-        }
-        
-        board[row][col] = num;
-        
-        if (SolveBoard(board)) {
-            return true;
-        }
-        
-        board[row][col] = EMPTY_CELL;
-    }
-    return false;
+bool SudokuBoard::SolveBoard(Grid& board) {
+    mSolver->SetRandomSource(&mRng);
+    return mSolver->Solve(board);
 }
 
-bool SudokuBoard::IsValidInRow(int row, int value) const {
-    int count = 0;
-    for (int col = 0; col < BOARD_SIZE; ++col) {
-        if (mBoard[row][col] == value) {
-            count++;
-        }
-    }
-    return count == 1;
+bool SudokuBoard::HasUniqueSolution() {
+    return mSolver->CountSolutions(GetGivens(), 2) == 1;
 }
 
-bool SudokuBoard::IsValidInColumn(int col, int value) const {
-    int count = 0;
-    for (int row = 0; row < BOARD_SIZE; ++row) {
-        if (mBoard[row][col] == value) {
-            count++;
-        }
+void SudokuBoard::SetSolverEngine(SolverEngine engine) {
+    if (mSolver->GetEngine() == engine) {
+        return;
     }
-    return count == 1;
+    mSolver = CreateSolver(engine);
+    mSolver->SetBranchingPolicy(mBranchingPolicy);
 }
 
-bool SudokuBoard::IsValidInBox(int boxRow, int boxCol, int value) const {
-    int count = 0;
-    int rowStart = boxRow * BOX_SIZE;
-    int colStart = boxCol * BOX_SIZE;
-    
-    for (int row = rowStart; row < rowStart + BOX_SIZE; ++row) {
-        for (int col = colStart; col < colStart + BOX_SIZE; ++col) {
-            if (mBoard[row][col] == value) {
-                count++;
-            }
-        }
-    }   
-    return count == 1;
+SolverEngine SudokuBoard::GetSolverEngine() const {
+    return mSolver->GetEngine();
+}
+
+void SudokuBoard::SetBranchingPolicy(BranchingPolicy policy) {
+    mBranchingPolicy = policy;
+    mSolver->SetBranchingPolicy(policy);
+}
+
+void SudokuBoard::SetGeneratorMode(GeneratorMode mode) {
+    mGeneratorMode = mode;
+}
+
+GeneratorMode SudokuBoard::GetGeneratorMode() const {
+    return mGeneratorMode;
+}
+
+const SolverStats& SudokuBoard::GetSolverStats() const {
+    return mSolver->GetStats();
+}
+
+void SudokuBoard::ResetSolverStats() {
+    mSolver->ResetStats();
 }
 
 bool SudokuBoard::IsNumberValid(int row, int col) const {
     if (row < 0 || row >= BOARD_SIZE || col < 0 || col >= BOARD_SIZE) {
         return false;
     }
+    return !mConflicts[row * BOARD_SIZE + col];
+}
+
+const SudokuBoard::ConflictMap& SudokuBoard::GetConflictMap() const {
+    return mConflicts;
+}
+
+void SudokuBoard::RefreshConflicts(int row, int col, int value) {
+    int cell = row * BOARD_SIZE + col;
+    mConflicts[cell] = HasConflict(row, col);
     
-    int value = mBoard[row][col];
-    if (value == EMPTY_CELL) {
-        return true;
-    }
-    
-    for (int c = 0; c < BOARD_SIZE; ++c) {
-        if (c != col && mBoard[row][c] == value) {
-            return false;
+    for (uint8_t peer : GetPeers()[cell]) {
+        if (mCells.Get(peer) == value) {
+            mConflicts[peer] = HasConflict(peer / BOARD_SIZE, peer % BOARD_SIZE);
         }
     }
-    
-    for (int r = 0; r < BOARD_SIZE; ++r) {
-        if (r != row && mBoard[r][col] == value) {
-            return false;
-        }
+}
+
+bool SudokuBoard::HasConflict(int row, int col) const {
+    int value = mCells.Get(row, col);
+    if (value == EMPTY_CELL) {
+        return false;
     }
-    
-    int boxRowStart = (row / BOX_SIZE) * BOX_SIZE;
-    int boxColStart = (col / BOX_SIZE) * BOX_SIZE;
-    
-    for (int r = boxRowStart; r < boxRowStart + BOX_SIZE; ++r) {
-        for (int c = boxColStart; c < boxColStart + BOX_SIZE; ++c) {
-            if ((r != row || c != col) && mBoard[r][c] == value) {
-                return false;
+    return mRowCounts[row][value] > 1 || mColCounts[col][value] > 1 ||
+           mBoxCounts[Solver::BoxIndex(row, col)][value] > 1;
+}
+
+const SudokuBoard::PeerTable& SudokuBoard::GetPeers() {
+    static const PeerTable peers = [] {
+        PeerTable table;
+        for (int cell = 0; cell < BOARD_SIZE * BOARD_SIZE; ++cell) {
+            int row = cell / BOARD_SIZE;
+            int col = cell % BOARD_SIZE;
+            int count = 0;
+            for (int other = 0; other < BOARD_SIZE * BOARD_SIZE; ++other) {
+                int otherRow = other / BOARD_SIZE;
+                int otherCol = other % BOARD_SIZE;
+                if (other != cell && (otherRow == row || otherCol == col ||
+                    Solver::BoxIndex(otherRow, otherCol) == Solver::BoxIndex(row, col))) {
+                    table[cell][count++] = static_cast<uint8_t>(other);
+                }
             }
         }
-    }
-    return true;
-} 
\ No newline at end of file
+        return table;
+    }();
+    return peers;
+}
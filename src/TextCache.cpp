@@ -0,0 +1,111 @@
+#include "TextCache.h"
+#include <iterator>
+
+TextCache::TextCache(size_t capacity)
+    : mCapacity(capacity > 0 ? capacity : 1)
+    , mHits(0)
+    , mMisses(0)
+{
+    mIndex.reserve(mCapacity);
+}
+
+TextCache::~TextCache() {
+    Clear();
+}
+
+const TextCache::Entry* TextCache::Get(SDL_Renderer* renderer, TTF_Font* font, const std::string& text, SDL_Color color) {
+    uint64_t key = MakeKey(font, text, color);
+
+    auto found = mIndex.find(key);
+    if (found != mIndex.end()) {
+        if (Matches(*found->second, font, text, color)) {
+            ++mHits;
+            mEntries.splice(mEntries.begin(), mEntries, found->second);
+            return &mEntries.front();
+        }
+        Evict(found->second);
+    }
+
+    ++mMisses;
+
+    SDL_Surface* surface = TTF_RenderText_Solid(font, text.c_str(), color);
+    if (!surface) {
+        return nullptr;
+    }
+
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    int width = surface->w;
+    int height = surface->h;
+    SDL_FreeSurface(surface);
+
+    if (!texture) {
+        return nullptr;
+    }
+
+    if (mEntries.size() >= mCapacity) {
+        Evict(std::prev(mEntries.end()));
+    }
+
+    mEntries.push_front({key, text, font, color, texture, width, height});
+    mIndex[key] = mEntries.begin();
+    return &mEntries.front();
+}
+
+void TextCache::Clear() {
+    for (Entry& entry : mEntries) {
+        SDL_DestroyTexture(entry.texture);
+    }
+    mEntries.clear();
+    mIndex.clear();
+}
+
+size_t TextCache::GetSize() const {
+    return mEntries.size();
+}
+
+size_t TextCache::GetCapacity() const {
+    return mCapacity;
+}
+
+uint64_t TextCache::GetHits() const {
+    return mHits;
+}
+
+uint64_t TextCache::GetMisses() const {
+    return mMisses;
+}
+
+void TextCache::ResetCounters() {
+    mHits = 0;
+    mMisses = 0;
+}
+
+uint64_t TextCache::MakeKey(TTF_Font* font, const std::string& text, SDL_Color color) {
+    const uint64_t prime = 1099511628211ULL;
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (unsigned char c : text) {
+        hash = (hash ^ c) * prime;
+    }
+
+    uint32_t packed = (static_cast<uint32_t>(color.r) << 24) | (static_cast<uint32_t>(color.g) << 16)
+        | (static_cast<uint32_t>(color.b) << 8) | color.a;
+    hash = (hash ^ packed) * prime;
+    hash = (hash ^ static_cast<uint64_t>(reinterpret_cast<uintptr_t>(font))) * prime;
+    return hash;
+}
+
+bool TextCache::Matches(const Entry& entry, TTF_Font* font, const std::string& text, SDL_Color color) {
+    return entry.font == font
+        && entry.color.r == color.r
+        && entry.color.g == color.g
+        && entry.color.b == color.b
+        && entry.color.a == color.a
+        && entry.text == text;
+}
+
+void TextCache::Evict(std::list<Entry>::iterator it) {
+    SDL_DestroyTexture(it->texture);
+    mIndex.erase(it->key);
+    mEntries.erase(it);
+}
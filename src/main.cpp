@@ -1,8 +1,15 @@
 #include "Game.h"
 #include <iostream>
+#include <cstring>
 
 int main(int argc, char* argv[]) {
     Game game;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--continuous") == 0) {
+            game.SetRenderOnDemand(false);
+        }
+    }
+    
     bool success = game.Initialize();
     if (success) {
         game.RunLoop();
@@ -0,0 +1,94 @@
+#include "AllocationCounter.h"
+#include "Solver.h"
+#include "SudokuBoard.h"
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace {
+
+const int PUZZLE_COUNT = 16;
+const int WARMUP_ROUNDS = 2;
+
+int gFailures = 0;
+
+void Expect(const char* name, uint64_t allocations) {
+    if (allocations != 0) {
+        std::printf("FAIL %-28s %llu allocations\n", name, static_cast<unsigned long long>(allocations));
+        ++gFailures;
+    } else {
+        std::printf("ok   %s\n", name);
+    }
+}
+
+template <typename Body>
+uint64_t CountAllocations(Body body) {
+    for (int round = 0; round < WARMUP_ROUNDS; ++round) {
+        body();
+    }
+    uint64_t before = gAllocations.load(std::memory_order_relaxed);
+    body();
+    return gAllocations.load(std::memory_order_relaxed) - before;
+}
+
+Solver::Grid ReadGrid(const SudokuBoard& board) {
+    Solver::Grid grid;
+    for (int row = 0; row < Solver::BOARD_SIZE; ++row) {
+        for (int col = 0; col < Solver::BOARD_SIZE; ++col) {
+            grid[row][col] = board.GetCell(row, col);
+        }
+    }
+    return grid;
+}
+
+}
+
+int main() {
+    std::vector<Solver::Grid> puzzles;
+    SudokuBoard source;
+    for (int i = 0; i < PUZZLE_COUNT; ++i) {
+        source.NewGame(1 + i % 3);
+        puzzles.push_back(ReadGrid(source));
+    }
+
+    const SolverEngine engines[] = {
+        SolverEngine::BACKTRACKING,
+        SolverEngine::DANCING_LINKS,
+        SolverEngine::SIMD_PROPAGATION
+    };
+    const char* solveNames[] = {"Solve/backtracking", "Solve/dancing_links", "Solve/simd"};
+    const char* countNames[] = {"CountSolutions/backtracking", "CountSolutions/dancing_links", "CountSolutions/simd"};
+
+    for (int e = 0; e < 3; ++e) {
+        std::unique_ptr<Solver> solver = CreateSolver(engines[e]);
+        Expect(solveNames[e], CountAllocations([&]() {
+            for (const Solver::Grid& puzzle : puzzles) {
+                Solver::Grid grid = puzzle;
+                solver->Solve(grid);
+            }
+        }));
+        Expect(countNames[e], CountAllocations([&]() {
+            for (const Solver::Grid& puzzle : puzzles) {
+                solver->CountSolutions(puzzle, 2);
+            }
+        }));
+    }
+
+    SudokuBoard board;
+    Expect("NewGame", CountAllocations([&]() {
+        for (int i = 0; i < PUZZLE_COUNT; ++i) {
+            board.NewGame(1 + i % 3);
+        }
+    }));
+    Expect("GetHint", CountAllocations([&]() {
+        board.NewGame(3);
+        int row;
+        int col;
+        int value;
+        while (board.GetHint(row, col, value)) {
+            board.SetCell(row, col, value);
+        }
+    }));
+
+    return gFailures == 0 ? 0 : 1;
+}
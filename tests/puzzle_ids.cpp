@@ -0,0 +1,68 @@
+#include "SudokuBoard.h"
+#include <cstdio>
+#include <string>
+
+namespace {
+
+struct StoredPuzzle {
+    const char* id;
+    const char* givens;
+};
+
+const StoredPuzzle kLegacyPuzzles[] = {
+    {"0101000000000001", "52..3.741..87956..3761.......7..3..6...51..7464.9872.5.95.6...82.1...467..4...9.3"},
+    {"01030800075BCD15", "6.4...2.9.8..3....9.......6..16.........48...5..7...2...6.8.3...7.....95...52..68"},
+    {"0101020000000001", "5..4.3..994..2....2.8.917.4..13578....52.4.7.372.6.45..3.879..2..4.3....85964..1."},
+    {"0101040000000001", "54...296.93.75...8......53...3815472.54....898.2..7.....9..8624.8..2.7.3.2..74815"},
+    {"01030100075BCD15", "3.4...1....5..7........6..78..74.....9.....3524..9.6.......4........821..81...5.."}
+};
+
+int gFailures = 0;
+
+void Expect(const std::string& name, bool ok) {
+    std::printf("%s %s\n", ok ? "ok  " : "FAIL", name.c_str());
+    if (!ok) {
+        ++gFailures;
+    }
+}
+
+std::string FormatGivens(const SudokuBoard& board) {
+    std::string text(SudokuBoard::BOARD_SIZE * SudokuBoard::BOARD_SIZE, '.');
+    for (size_t cell = 0; cell < text.size(); ++cell) {
+        int value = board.GetCell(static_cast<int>(cell) / SudokuBoard::BOARD_SIZE, static_cast<int>(cell) % SudokuBoard::BOARD_SIZE);
+        if (value != SudokuBoard::EMPTY_CELL) {
+            text[cell] = static_cast<char>('0' + value);
+        }
+    }
+    return text;
+}
+
+}
+
+int main() {
+    for (const StoredPuzzle& stored : kLegacyPuzzles) {
+        uint64_t id = 0;
+        SudokuBoard board(1u);
+        bool ok = SudokuBoard::ParsePuzzleId(stored.id, id) && board.NewGameFromId(id) &&
+            board.GetPuzzleId() == id && FormatGivens(board) == stored.givens &&
+            board.GetGeneratorMode() == GeneratorMode::TRANSFORM &&
+            board.GetSolverEngine() == SolverEngine::BACKTRACKING;
+        Expect(std::string("v1 ") + stored.id, ok);
+    }
+
+    const GeneratorMode modes[] = {GeneratorMode::TRANSFORM, GeneratorMode::SOLVER};
+    for (GeneratorMode mode : modes) {
+        SudokuBoard source(2u);
+        source.SetGeneratorMode(mode);
+        source.NewGame(3);
+
+        uint64_t id = 0;
+        std::string text = SudokuBoard::FormatPuzzleId(source.GetPuzzleId());
+        SudokuBoard board(3u);
+        bool ok = SudokuBoard::ParsePuzzleId(text.c_str(), id) && board.NewGameFromId(id) &&
+            board.GetPuzzleId() == source.GetPuzzleId() && FormatGivens(board) == FormatGivens(source);
+        Expect("v2 " + text, ok);
+    }
+
+    return gFailures == 0 ? 0 : 1;
+}
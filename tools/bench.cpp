@@ -0,0 +1,317 @@
+#include "AllocationCounter.h"
+#include "GridGenerator.h"
+#include "SudokuBoard.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    uint32_t seed = 12345;
+    std::string json;
+    std::string filter;
+    int scale = 1;
+};
+
+struct Result {
+    std::string name;
+    uint64_t ops;
+    double nsPerOp;
+    double p50;
+    double p99;
+    double allocsPerOp;
+};
+
+volatile int gSink = 0;
+
+class Bench {
+public:
+    explicit Bench(const Options& options)
+        : mOptions(options)
+    {
+    }
+
+    template <typename Op>
+    void Run(const std::string& name, int batchSize, int batches, Op op) {
+        if (!mOptions.filter.empty() && name.find(mOptions.filter) == std::string::npos) {
+            return;
+        }
+
+        batches *= mOptions.scale;
+        std::vector<double> samples;
+        samples.reserve(batches);
+
+        uint64_t allocationsBefore = gAllocations.load(std::memory_order_relaxed);
+        double totalNs = 0.0;
+        uint64_t index = 0;
+
+        for (int batch = 0; batch < batches; ++batch) {
+            Clock::time_point start = Clock::now();
+            for (int i = 0; i < batchSize; ++i) {
+                op(index++);
+            }
+            double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            totalNs += ns;
+            samples.push_back(ns / batchSize);
+        }
+
+        uint64_t allocations = gAllocations.load(std::memory_order_relaxed) - allocationsBefore;
+        std::sort(samples.begin(), samples.end());
+
+        Result result;
+        result.name = name;
+        result.ops = index;
+        result.nsPerOp = totalNs / index;
+        result.p50 = Percentile(samples, 0.50);
+        result.p99 = Percentile(samples, 0.99);
+        result.allocsPerOp = static_cast<double>(allocations) / index;
+        mResults.push_back(result);
+
+        std::printf("%-28s %10llu ops %12.1f ns/op %12.1f p50 %12.1f p99 %8.2f allocs/op\n",
+            result.name.c_str(), static_cast<unsigned long long>(result.ops), result.nsPerOp,
+            result.p50, result.p99, result.allocsPerOp);
+        std::fflush(stdout);
+    }
+
+    bool WriteJson(const std::string& path) const {
+        FILE* file = std::fopen(path.c_str(), "w");
+        if (!file) {
+            return false;
+        }
+
+        std::fprintf(file, "{\n  \"seed\": %u,\n  \"benchmarks\": [\n", mOptions.seed);
+        for (size_t i = 0; i < mResults.size(); ++i) {
+            const Result& result = mResults[i];
+            std::fprintf(file,
+                "    {\"name\": \"%s\", \"ops\": %llu, \"ns_per_op\": %.3f, \"p50_ns\": %.3f, "
+                "\"p99_ns\": %.3f, \"allocs_per_op\": %.4f}%s\n",
+                result.name.c_str(), static_cast<unsigned long long>(result.ops), result.nsPerOp,
+                result.p50, result.p99, result.allocsPerOp, i + 1 < mResults.size() ? "," : "");
+        }
+        std::fprintf(file, "  ]\n}\n");
+        return std::fclose(file) == 0;
+    }
+
+private:
+    static double Percentile(const std::vector<double>& sorted, double percentile) {
+        if (sorted.empty()) {
+            return 0.0;
+        }
+        size_t rank = static_cast<size_t>(percentile * (sorted.size() - 1) + 0.5);
+        return sorted[rank];
+    }
+
+    Options mOptions;
+    std::vector<Result> mResults;
+};
+
+const char* DifficultyName(int difficulty) {
+    switch (difficulty) {
+        case 1: return "easy";
+        case 2: return "medium";
+        default: return "hard";
+    }
+}
+
+const char* EngineName(SolverEngine engine) {
+    switch (engine) {
+        case SolverEngine::BACKTRACKING: return "backtracking";
+        case SolverEngine::DANCING_LINKS: return "dancing_links";
+        case SolverEngine::SIMD_PROPAGATION: return "simd";
+    }
+    return "unknown";
+}
+
+std::vector<GeneratedPuzzle> GeneratePuzzles(uint32_t seed, int difficulty, int count) {
+    SudokuBoard board(seed);
+    std::vector<GeneratedPuzzle> puzzles;
+    puzzles.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        board.NewGame(difficulty);
+        puzzles.push_back(board.ExportPuzzle());
+    }
+    return puzzles;
+}
+
+std::vector<Solver::Grid> UnpackGivens(const std::vector<GeneratedPuzzle>& puzzles) {
+    std::vector<Solver::Grid> grids(puzzles.size());
+    for (size_t i = 0; i < puzzles.size(); ++i) {
+        puzzles[i].givens.ToGrid(grids[i]);
+    }
+    return grids;
+}
+
+void Reseed(std::mt19937& rng, uint32_t seed) {
+    rng.seed(seed);
+}
+
+void Reseed(Pcg32& rng, uint32_t seed) {
+    rng.Seed(seed);
+}
+
+template <typename Engine>
+void RunRandomBenchmarks(Bench& bench, const Options& options, const std::string& name) {
+    Engine rng(options.seed);
+    bench.Run("Random/seed/" + name, 64, 1000, [&](uint64_t i) {
+        Reseed(rng, static_cast<uint32_t>(i));
+        gSink += static_cast<int>(rng() & 1);
+    });
+
+    bench.Run("Random/below/" + name, 1024, 2000, [&](uint64_t i) {
+        gSink += static_cast<int>(RandomBelow(rng, static_cast<uint32_t>(i % 81) + 1));
+    });
+
+    std::array<int, SudokuBoard::BOARD_SIZE * SudokuBoard::BOARD_SIZE> cells;
+    for (size_t i = 0; i < cells.size(); ++i) {
+        cells[i] = static_cast<int>(i);
+    }
+    bench.Run("Random/shuffle81/" + name, 64, 2000, [&](uint64_t) {
+        Shuffle(cells.begin(), cells.end(), rng);
+        gSink += cells[0];
+    });
+}
+
+void RunBenchmarks(Bench& bench, const Options& options) {
+    RunRandomBenchmarks<std::mt19937>(bench, options, "mt19937");
+    RunRandomBenchmarks<Pcg32>(bench, options, "pcg32");
+
+    for (int difficulty = 1; difficulty <= 3; ++difficulty) {
+        SudokuBoard board(options.seed);
+        bench.Run(std::string("NewGame/") + DifficultyName(difficulty), 1, 200, [&](uint64_t) {
+            board.NewGame(difficulty);
+        });
+    }
+
+    {
+        RandomEngine rng(options.seed);
+        std::unique_ptr<Solver> solver = CreateSolver(SolverEngine::BACKTRACKING);
+        solver->SetRandomSource(&rng);
+        Solver::Grid grid;
+        bench.Run("FillGrid/solver", 16, 500, [&](uint64_t) {
+            grid = {};
+            gSink += solver->Solve(grid) ? grid[0][0] : 0;
+        });
+        bench.Run("FillGrid/transform", 1024, 2000, [&](uint64_t) {
+            GridGenerator::Generate(grid, rng);
+            gSink += grid[0][0];
+        });
+    }
+
+    for (int difficulty = 1; difficulty <= 3; ++difficulty) {
+        std::vector<Solver::Grid> graded = UnpackGivens(GeneratePuzzles(options.seed, difficulty, 100));
+        bench.Run(std::string("Grade/") + DifficultyName(difficulty), 1, 2000, [&](uint64_t i) {
+            PuzzleGrade grade;
+            gSink += Grader::Grade(graded[i % graded.size()], grade) ? grade.score : 0;
+        });
+    }
+
+    {
+        SudokuBoard board(options.seed);
+        bench.Run("NewGame/target_xy_wing", 1, 20, [&](uint64_t) {
+            gSink += board.NewGame(3, Technique::XY_WING) ? 1 : 0;
+        });
+    }
+
+    std::vector<GeneratedPuzzle> puzzles = GeneratePuzzles(options.seed, 3, 100);
+    std::vector<Solver::Grid> grids = UnpackGivens(puzzles);
+    const SolverEngine engines[] = {
+        SolverEngine::BACKTRACKING, SolverEngine::DANCING_LINKS, SolverEngine::SIMD_PROPAGATION
+    };
+    for (SolverEngine engine : engines) {
+        std::unique_ptr<Solver> solver = CreateSolver(engine);
+        Solver::Grid grid;
+        bench.Run(std::string("SolveBoard/") + EngineName(engine), 1, 2000, [&](uint64_t i) {
+            grid = grids[i % grids.size()];
+            gSink += solver->Solve(grid) ? grid[0][0] : 0;
+        });
+    }
+
+    std::vector<Solver::Grid> gridCopies(grids.size());
+    bench.Run("Copy/grid", 1024, 2000, [&](uint64_t i) {
+        gridCopies[i % grids.size()] = grids[(i + 1) % grids.size()];
+        gSink += gridCopies[i % grids.size()][0][0];
+    });
+
+    std::vector<PackedBoard> packed(puzzles.size());
+    for (size_t i = 0; i < puzzles.size(); ++i) {
+        packed[i] = puzzles[i].givens;
+    }
+    std::vector<PackedBoard> packedCopies(packed.size());
+    bench.Run("Copy/packed", 1024, 2000, [&](uint64_t i) {
+        packedCopies[i % packed.size()] = packed[(i + 1) % packed.size()];
+        gSink += packedCopies[i % packed.size()].Get(0);
+    });
+
+    bench.Run("Hash/packed", 1024, 2000, [&](uint64_t i) {
+        gSink += static_cast<int>(packed[i % packed.size()].Hash());
+    });
+
+    SudokuBoard board(options.seed);
+    board.LoadGeneratedPuzzle(puzzles.front());
+    const int cells = SudokuBoard::BOARD_SIZE * SudokuBoard::BOARD_SIZE;
+
+    bench.Run("IsValidMove", 1024, 2000, [&](uint64_t i) {
+        int cell = static_cast<int>(i % cells);
+        int value = static_cast<int>(i % SudokuBoard::BOARD_SIZE) + 1;
+        gSink += board.IsValidMove(cell / SudokuBoard::BOARD_SIZE, cell % SudokuBoard::BOARD_SIZE, value);
+    });
+
+    bench.Run("IsNumberValid", 1024, 2000, [&](uint64_t i) {
+        int cell = static_cast<int>(i % cells);
+        gSink += board.IsNumberValid(cell / SudokuBoard::BOARD_SIZE, cell % SudokuBoard::BOARD_SIZE);
+    });
+
+    bench.Run("IsSolved", 1024, 2000, [&](uint64_t) {
+        gSink += board.IsSolved();
+    });
+
+    bench.Run("GetHint", 1024, 2000, [&](uint64_t) {
+        int row, col, value;
+        gSink += board.GetHint(row, col, value) ? value : 0;
+    });
+}
+
+bool ParseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+            options.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--json") == 0 && hasValue) {
+            options.json = argv[++i];
+        } else if (std::strcmp(argv[i], "--filter") == 0 && hasValue) {
+            options.filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--scale") == 0 && hasValue) {
+            options.scale = std::max(1, std::atoi(argv[++i]));
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::fprintf(stderr, "Usage: %s [--seed N] [--json FILE] [--filter NAME] [--scale N]\n", argv[0]);
+        return 2;
+    }
+
+    Bench bench(options);
+    RunBenchmarks(bench, options);
+
+    if (!options.json.empty() && !bench.WriteJson(options.json)) {
+        std::fprintf(stderr, "Cannot write %s\n", options.json.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,246 @@
+#include "GameSession.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+enum class MoveType {
+    ENTER,
+    CLEAR,
+    HINT
+};
+
+struct Move {
+    MoveType type;
+    int row;
+    int col;
+    int value;
+};
+
+struct Options {
+    int games = 100;
+    int difficulty = 2;
+    int replays = 1000;
+    unsigned seed = 1;
+    std::string script;
+};
+
+void PrintUsage(const char* program) {
+    std::fprintf(stderr,
+        "Usage: %s [--games N] [--difficulty 1-3] [--replays N] [--seed N] [--script FILE]\n"
+        "\n"
+        "Without --script, each game generates one puzzle and replays a random\n"
+        "play-through of it (entries, clears, mistakes and a final hint) N times.\n"
+        "A script holds one command per line: new <difficulty>, set <row> <col> <value>,\n"
+        "id <puzzle id>, clear <row> <col>, hint, menu. Lines starting with # are ignored.\n",
+        program);
+}
+
+bool ParseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--games") == 0 && hasValue) {
+            options.games = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--difficulty") == 0 && hasValue) {
+            options.difficulty = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--replays") == 0 && hasValue) {
+            options.replays = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+            options.seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--script") == 0 && hasValue) {
+            options.script = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return options.games > 0 && options.replays > 0
+        && options.difficulty >= 1 && options.difficulty <= 3;
+}
+
+int FindConflictingValue(const GeneratedPuzzle& puzzle, int row) {
+    for (int col = 0; col < SudokuBoard::BOARD_SIZE; ++col) {
+        if (puzzle.givens.Get(row, col) != SudokuBoard::EMPTY_CELL) {
+            return puzzle.givens.Get(row, col);
+        }
+    }
+    return SudokuBoard::EMPTY_CELL;
+}
+
+std::vector<Move> BuildPlaythrough(const GeneratedPuzzle& puzzle, RandomEngine& rng) {
+    std::vector<Move> moves;
+    std::vector<int> cells;
+    for (int cell = 0; cell < SudokuBoard::BOARD_SIZE * SudokuBoard::BOARD_SIZE; ++cell) {
+        if (puzzle.givens.Get(cell) == SudokuBoard::EMPTY_CELL) {
+            cells.push_back(cell);
+        }
+    }
+    Shuffle(cells.begin(), cells.end(), rng);
+
+    int mistakesLeft = GameSession::MAX_MISTAKES - 1;
+    for (size_t i = 0; i < cells.size(); ++i) {
+        int row = cells[i] / SudokuBoard::BOARD_SIZE;
+        int col = cells[i] % SudokuBoard::BOARD_SIZE;
+        int answer = puzzle.solution.Get(row, col);
+
+        if (i + 1 == cells.size()) {
+            moves.push_back({MoveType::HINT, row, col, answer});
+            continue;
+        }
+
+        switch (RandomBelow(rng, 8)) {
+            case 0: {
+                int conflicting = FindConflictingValue(puzzle, row);
+                if (mistakesLeft > 0 && conflicting != SudokuBoard::EMPTY_CELL) {
+                    moves.push_back({MoveType::ENTER, row, col, conflicting});
+                    --mistakesLeft;
+                }
+                break;
+            }
+            case 1:
+                moves.push_back({MoveType::ENTER, row, col, answer});
+                moves.push_back({MoveType::CLEAR, row, col, SudokuBoard::EMPTY_CELL});
+                break;
+            default:
+                break;
+        }
+        moves.push_back({MoveType::ENTER, row, col, answer});
+    }
+    return moves;
+}
+
+void ApplyMove(GameSession& session, const Move& move) {
+    int row, col, value;
+    switch (move.type) {
+        case MoveType::ENTER:
+            session.EnterNumber(move.row, move.col, move.value);
+            break;
+        case MoveType::CLEAR:
+            session.ClearEntry(move.row, move.col);
+            break;
+        case MoveType::HINT:
+            session.ApplyHint(row, col, value);
+            break;
+    }
+}
+
+const char* StateName(GameState state) {
+    switch (state) {
+        case GameState::MENU: return "menu";
+        case GameState::PLAYING: return "playing";
+        case GameState::SOLVED: return "solved";
+        case GameState::WIN: return "win";
+        case GameState::GAME_OVER: return "game over";
+    }
+    return "unknown";
+}
+
+int RunScript(const Options& options) {
+    std::ifstream file(options.script);
+    if (!file) {
+        std::fprintf(stderr, "Cannot open script %s\n", options.script.c_str());
+        return 1;
+    }
+
+    GameSession session;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        std::istringstream stream(line);
+        std::string command;
+        if (!(stream >> command) || command[0] == '#') {
+            continue;
+        }
+
+        int a = 0, b = 0, c = 0;
+        std::string text;
+        uint64_t id = 0;
+        if (command == "new" && stream >> a) {
+            session.Start(a);
+        } else if (command == "id" && stream >> text && SudokuBoard::ParsePuzzleId(text.c_str(), id)) {
+            if (!session.StartFromId(id)) {
+                std::fprintf(stderr, "%s:%d: unsupported puzzle id '%s'\n", options.script.c_str(), lineNumber, text.c_str());
+                return 1;
+            }
+        } else if (command == "set" && stream >> a >> b >> c) {
+            session.EnterNumber(a, b, c);
+        } else if (command == "clear" && stream >> a >> b) {
+            session.ClearEntry(a, b);
+        } else if (command == "hint") {
+            session.ApplyHint(a, b, c);
+        } else if (command == "menu") {
+            session.ReturnToMenu();
+        } else {
+            std::fprintf(stderr, "%s:%d: bad command '%s'\n", options.script.c_str(), lineNumber, line.c_str());
+            return 1;
+        }
+    }
+
+    std::printf("state=%s mistakes=%d moves=%llu id=%s\n", StateName(session.GetState()), session.GetMistakes(),
+        static_cast<unsigned long long>(session.GetMoveCount()),
+        SudokuBoard::FormatPuzzleId(session.GetBoard().GetPuzzleId()).c_str());
+    return 0;
+}
+
+int RunPlaythroughs(const Options& options) {
+    using Clock = std::chrono::steady_clock;
+
+    RandomEngine rng(options.seed);
+    GameSession session;
+    session.GetBoard().Seed(options.seed);
+    uint64_t moveCount = 0;
+    uint64_t wins = 0;
+    double generateSeconds = 0.0;
+    double playSeconds = 0.0;
+
+    for (int game = 0; game < options.games; ++game) {
+        Clock::time_point generateStart = Clock::now();
+        session.Start(options.difficulty);
+        GeneratedPuzzle puzzle = session.GetBoard().ExportPuzzle();
+        generateSeconds += std::chrono::duration<double>(Clock::now() - generateStart).count();
+
+        std::vector<Move> moves = BuildPlaythrough(puzzle, rng);
+
+        Clock::time_point playStart = Clock::now();
+        for (int replay = 0; replay < options.replays; ++replay) {
+            session.Start(puzzle);
+            for (const Move& move : moves) {
+                ApplyMove(session, move);
+            }
+            wins += session.GetState() == GameState::WIN ? 1 : 0;
+        }
+        playSeconds += std::chrono::duration<double>(Clock::now() - playStart).count();
+        moveCount += static_cast<uint64_t>(moves.size()) * options.replays;
+    }
+
+    uint64_t played = static_cast<uint64_t>(options.games) * options.replays;
+    std::printf("games=%d replays=%d played=%llu wins=%llu\n", options.games, options.replays,
+        static_cast<unsigned long long>(played), static_cast<unsigned long long>(wins));
+    std::printf("generate: %.3f ms/game\n", generateSeconds * 1000.0 / options.games);
+    std::printf("play: %llu moves in %.3f s, %.0f moves/s\n", static_cast<unsigned long long>(moveCount),
+        playSeconds, playSeconds > 0.0 ? moveCount / playSeconds : 0.0);
+
+    return wins == played ? 0 : 1;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    if (!options.script.empty()) {
+        return RunScript(options);
+    }
+    return RunPlaythroughs(options);
+}
@@ -0,0 +1,353 @@
+#include "BatchSolver.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const int CELL_COUNT = Solver::BOARD_SIZE * Solver::BOARD_SIZE;
+const int HISTOGRAM_BUCKETS = 40;
+
+using Histogram = std::array<uint64_t, HISTOGRAM_BUCKETS>;
+
+class MappedFile {
+public:
+    MappedFile()
+        : mData(nullptr)
+        , mSize(0)
+#ifdef _WIN32
+        , mFile(INVALID_HANDLE_VALUE)
+        , mMapping(nullptr)
+#endif
+    {
+    }
+
+    ~MappedFile() {
+        Close();
+    }
+
+    bool Open(const char* path) {
+#ifdef _WIN32
+        mFile = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (mFile == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(mFile, &size)) {
+            return false;
+        }
+        mSize = static_cast<size_t>(size.QuadPart);
+        if (mSize == 0) {
+            return true;
+        }
+        mMapping = CreateFileMappingA(mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mMapping) {
+            return false;
+        }
+        mData = static_cast<const char*>(MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+        return mData != nullptr;
+#else
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            return false;
+        }
+        mSize = static_cast<size_t>(info.st_size);
+        if (mSize == 0) {
+            close(fd);
+            return true;
+        }
+        void* data = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) {
+            return false;
+        }
+        madvise(data, mSize, MADV_SEQUENTIAL);
+        mData = static_cast<const char*>(data);
+        return true;
+#endif
+    }
+
+    void Close() {
+#ifdef _WIN32
+        if (mData) {
+            UnmapViewOfFile(mData);
+        }
+        if (mMapping) {
+            CloseHandle(mMapping);
+            mMapping = nullptr;
+        }
+        if (mFile != INVALID_HANDLE_VALUE) {
+            CloseHandle(mFile);
+            mFile = INVALID_HANDLE_VALUE;
+        }
+#else
+        if (mData) {
+            munmap(const_cast<char*>(mData), mSize);
+        }
+#endif
+        mData = nullptr;
+        mSize = 0;
+    }
+
+    const char* GetData() const {
+        return mData;
+    }
+
+    size_t GetSize() const {
+        return mSize;
+    }
+
+private:
+    const char* mData;
+    size_t mSize;
+#ifdef _WIN32
+    HANDLE mFile;
+    HANDLE mMapping;
+#endif
+};
+
+struct Options {
+    const char* input = nullptr;
+    int threads = 0;
+    SolverEngine engine = SolverEngine::BACKTRACKING;
+    size_t chunkSize = 65536;
+    bool quiet = false;
+};
+
+struct Line {
+    size_t offset;
+    size_t length;
+};
+
+struct Totals {
+    Histogram histogram{};
+    uint64_t solved = 0;
+    uint64_t failed = 0;
+    uint64_t malformed = 0;
+};
+
+std::vector<Line> SplitLines(const char* data, size_t size) {
+    std::vector<Line> lines;
+    lines.reserve(size / (CELL_COUNT + 1) + 1);
+
+    size_t offset = 0;
+    while (offset < size) {
+        const char* end = static_cast<const char*>(std::memchr(data + offset, '\n', size - offset));
+        size_t next = end ? static_cast<size_t>(end - data) : size;
+        size_t length = next - offset;
+        if (length > 0 && data[offset + length - 1] == '\r') {
+            --length;
+        }
+        if (length > 0) {
+            lines.push_back({offset, length});
+        }
+        offset = next + 1;
+    }
+    return lines;
+}
+
+int BucketFor(uint64_t nanoseconds) {
+    int bucket = 0;
+    while (nanoseconds > 1 && bucket < HISTOGRAM_BUCKETS - 1) {
+        nanoseconds >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+Totals SolveLines(const Options& options, const char* data, const std::vector<Line>& lines) {
+    BatchSolver solver(options.threads, options.engine);
+    Totals totals;
+
+    std::vector<Puzzle> puzzles;
+    std::vector<Solution> solutions;
+    std::vector<uint8_t> parsed;
+    std::string output;
+
+    for (size_t first = 0; first < lines.size(); first += options.chunkSize) {
+        size_t count = std::min(options.chunkSize, lines.size() - first);
+        puzzles.resize(count);
+        parsed.resize(count);
+
+        size_t valid = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const Line& line = lines[first + i];
+            parsed[i] = puzzles[valid].Parse(data + line.offset, line.length);
+            valid += parsed[i];
+        }
+        puzzles.resize(valid);
+        solutions.resize(valid);
+
+        solver.SolveBatch(puzzles, solutions);
+
+        output.clear();
+        output.reserve(count * (CELL_COUNT + 1));
+        size_t next = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (!parsed[i]) {
+                ++totals.malformed;
+                output.append(CELL_COUNT, '.');
+                output.push_back('\n');
+                continue;
+            }
+
+            const Solution& solution = solutions[next++];
+            ++totals.histogram[BucketFor(solution.elapsedNs)];
+            if (!solution.solved) {
+                ++totals.failed;
+                output.append(CELL_COUNT, '.');
+                output.push_back('\n');
+                continue;
+            }
+
+            ++totals.solved;
+            size_t offset = output.size();
+            output.resize(offset + PackedBoard::TEXT_LENGTH);
+            solution.board.Format(&output[offset]);
+            output.push_back('\n');
+        }
+        std::fwrite(output.data(), 1, output.size(), stdout);
+    }
+
+    std::fflush(stdout);
+    return totals;
+}
+
+double BucketUpperMicroseconds(int bucket) {
+    return static_cast<double>(uint64_t(1) << (bucket + 1)) / 1000.0;
+}
+
+double HistogramPercentile(const Histogram& histogram, uint64_t total, double percentile) {
+    uint64_t target = static_cast<uint64_t>(percentile * total);
+    uint64_t seen = 0;
+    for (int i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+        seen += histogram[i];
+        if (seen > target) {
+            return BucketUpperMicroseconds(i);
+        }
+    }
+    return BucketUpperMicroseconds(HISTOGRAM_BUCKETS - 1);
+}
+
+void PrintReport(const Totals& totals, double seconds, int threads) {
+    uint64_t total = totals.solved + totals.failed;
+    std::fprintf(stderr, "puzzles=%llu solved=%llu failed=%llu malformed=%llu threads=%d\n",
+        static_cast<unsigned long long>(total), static_cast<unsigned long long>(totals.solved),
+        static_cast<unsigned long long>(totals.failed), static_cast<unsigned long long>(totals.malformed), threads);
+    std::fprintf(stderr, "elapsed %.3f s, %.0f puzzles/s\n", seconds, seconds > 0.0 ? total / seconds : 0.0);
+
+    if (total == 0) {
+        return;
+    }
+
+    std::fprintf(stderr, "latency p50 <= %.1f us, p99 <= %.1f us, p99.9 <= %.1f us\n",
+        HistogramPercentile(totals.histogram, total, 0.50),
+        HistogramPercentile(totals.histogram, total, 0.99),
+        HistogramPercentile(totals.histogram, total, 0.999));
+
+    uint64_t largest = *std::max_element(totals.histogram.begin(), totals.histogram.end());
+    for (int i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+        if (totals.histogram[i] == 0) {
+            continue;
+        }
+        int width = static_cast<int>(50 * totals.histogram[i] / largest);
+        std::fprintf(stderr, "  <= %12.1f us %10llu %s\n", BucketUpperMicroseconds(i),
+            static_cast<unsigned long long>(totals.histogram[i]), std::string(std::max(width, 1), '#').c_str());
+    }
+}
+
+bool ParseEngine(const char* name, SolverEngine& engine) {
+    if (std::strcmp(name, "backtracking") == 0) {
+        engine = SolverEngine::BACKTRACKING;
+    } else if (std::strcmp(name, "dlx") == 0) {
+        engine = SolverEngine::DANCING_LINKS;
+    } else if (std::strcmp(name, "simd") == 0) {
+        engine = SolverEngine::SIMD_PROPAGATION;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool ParseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+            options.threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--engine") == 0 && hasValue) {
+            if (!ParseEngine(argv[++i], options.engine)) {
+                return false;
+            }
+        } else if (std::strcmp(argv[i], "--chunk") == 0 && hasValue) {
+            options.chunkSize = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (std::strcmp(argv[i], "--quiet") == 0) {
+            options.quiet = true;
+        } else if (argv[i][0] != '-' && !options.input) {
+            options.input = argv[i];
+        } else {
+            return false;
+        }
+    }
+
+    if (options.threads <= 0) {
+        options.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return options.input != nullptr;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::fprintf(stderr,
+            "Usage: %s [--threads N] [--engine backtracking|dlx|simd] [--chunk N] [--quiet] FILE\n"
+            "\n"
+            "Solves one 81-character puzzle per line ('1'-'9' givens, '0' or '.' empty) and\n"
+            "writes one solution per line to stdout in input order. Unsolvable or malformed\n"
+            "lines produce a line of 81 '.' characters. Statistics go to stderr.\n",
+            argv[0]);
+        return 2;
+    }
+
+    MappedFile file;
+    if (!file.Open(options.input)) {
+        std::fprintf(stderr, "Cannot map %s\n", options.input);
+        return 1;
+    }
+
+    Clock::time_point start = Clock::now();
+    std::vector<Line> lines = SplitLines(file.GetData(), file.GetSize());
+
+    Totals totals = SolveLines(options, file.GetData(), lines);
+
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    if (!options.quiet) {
+        PrintReport(totals, seconds, options.threads);
+    }
+    return totals.failed == 0 && totals.malformed == 0 ? 0 : 1;
+}